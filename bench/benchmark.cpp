@@ -0,0 +1,382 @@
+#include "../include/ClosedSet.h"
+#include "../include/FlatBitGrid.h"
+#include "../include/Grid.h"
+#include "../include/Position.h"
+#include "../include/Problem.h"
+#include "../include/Tetromino.h"
+#include "../include/astar.h"
+#include "../include/batch.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace {
+struct BenchmarkOptions {
+  // Time each benchmark runs for, at least
+  double min_time_secs{0.5};
+  // If not empty, only benchmarks whose name contains it are run
+  std::string filter{};
+  // Input files (or directories of them) that are solved
+  std::vector<std::string> paths{};
+  // If not empty, input files are named relative to it, so that results of different checkouts
+  // can be compared
+  std::string base_dir{};
+};
+
+/**
+ * Keeps the compiler from optimising away the computation of `value`, or from assuming that
+ * memory is unchanged across the call.
+ */
+template <typename T>
+void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  // Passes the address rather than the value, so that large values are not copied
+  asm volatile("" : : "r"(&value) : "memory");
+#else
+  static const volatile void* sink{};
+  sink = &value;
+#endif
+}
+
+/**
+ * Returns the most memory the process has held in RAM at once, in bytes, if known.
+ */
+std::optional<std::size_t> peak_rss_bytes() {
+#if defined(__unix__) || defined(__APPLE__)
+  rusage usage{};
+
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return std::nullopt;
+  }
+
+#if defined(__APPLE__)
+  return static_cast<std::size_t>(usage.ru_maxrss);
+#else
+  return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+  return std::nullopt;
+#endif
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start_time) {
+  return std::chrono::duration_cast<std::chrono::duration<double>>(
+             std::chrono::steady_clock::now() - start_time
+  )
+      .count();
+}
+
+bool is_selected(const BenchmarkOptions& options, std::string_view name) {
+  return name.find(options.filter) != std::string_view::npos;
+}
+
+/**
+ * Calls `op(i)` for i = 0, 1, 2, ... in doubling batches until at least `options.min_time_secs`
+ * have passed, then writes a JSON result line with the mean time per operation, where each call
+ * performs `ops_per_call` operations.
+ */
+template <typename Op>
+void run_micro(
+    const BenchmarkOptions& options, const std::string& name, Op op, std::size_t ops_per_call = 1
+) {
+  if (!is_selected(options, name)) {
+    return;
+  }
+
+  std::size_t num_calls{0};
+  double elapsed_secs{0.0};
+  auto start_time{std::chrono::steady_clock::now()};
+
+  for (std::size_t batch_size{1}; elapsed_secs < options.min_time_secs; batch_size *= 2) {
+    for (std::size_t i{0}; i < batch_size; ++i) {
+      op(num_calls + i);
+    }
+
+    num_calls += batch_size;
+    elapsed_secs = seconds_since(start_time);
+  }
+
+  auto num_ops{num_calls * ops_per_call};
+  std::cout << "{\"benchmark\":" << to_json_string(name) << ",\"ops\":" << num_ops
+            << ",\"ns_per_op\":" << std::fixed << std::setprecision(2)
+            << 1e9 * elapsed_secs / static_cast<double>(num_ops) << "}\n"
+            << std::defaultfloat;
+}
+
+/**
+ * Returns `num_positions` positions spread over a `Width`x`Height` grid, the same on every run and
+ * with every toolchain.
+ */
+template <int Width, int Height>
+std::vector<Position> random_positions(std::size_t num_positions) {
+  // The output of `std::mt19937` is fixed by the standard, unlike those of distributions, so the
+  // positions are the same with every standard library
+  std::mt19937 rng{};
+  std::vector<Position> positions(num_positions);
+
+  for (auto& pos : positions) {
+    pos.x = static_cast<int>(rng() % Width);
+    pos.y = static_cast<int>(rng() % Height);
+  }
+
+  return positions;
+}
+
+/**
+ * Returns a `Width`x`Height` problem from the top-left to the bottom-right corner, with obstacles
+ * on about 1 in 11 positions, the same on every run.
+ */
+template <int Width, int Height>
+Problem<Width, Height> benchmark_problem() {
+  std::vector<Position> obstacles{};
+
+  for (int y{0}; y < Height; ++y) {
+    for (int x{0}; x < Width; ++x) {
+      if ((x * 7 + y * 13) % 11 == 5) {
+        obstacles.push_back({x, y});
+      }
+    }
+  }
+
+  return {{0, 0}, {Width - 1, Height - 1}, obstacles};
+}
+
+/**
+ * Runs the benchmarks of bit grids, grids, and closed sets on a `Width`x`Height` grid.
+ */
+template <int Width, int Height>
+void run_grid_benchmarks(const BenchmarkOptions& options) {
+  // Masks indices into `positions`, whose size is a power of 2
+  constexpr std::size_t POSITION_MASK{1023};
+  auto positions{random_positions<Width, Height>(POSITION_MASK + 1)};
+  auto dimensions{std::to_string(Width) + "," + std::to_string(Height)};
+
+  // About a fifth of the positions are set, as in a grid well into a search
+  FlatBitGrid<Width, Height> flat_bit_grid{};
+
+  for (auto pos : random_positions<Width, Height>(Width * Height / 4)) {
+    flat_bit_grid.set(pos);
+  }
+
+  // Set positions in a copy, so that the grid read below is unchanged
+  auto flat_bit_grid_copy{flat_bit_grid};
+
+  run_micro(options, "FlatBitGrid<" + dimensions + ">::set", [&](std::size_t i) {
+    flat_bit_grid_copy.set(positions[i & POSITION_MASK]);
+    do_not_optimize(flat_bit_grid_copy);
+  });
+  run_micro(options, "FlatBitGrid<" + dimensions + ">::is_set", [&](std::size_t i) {
+    do_not_optimize(flat_bit_grid.is_set(positions[i & POSITION_MASK]));
+  });
+  run_micro(options, "FlatBitGrid<" + dimensions + ">::hash", [&](std::size_t) {
+    do_not_optimize(flat_bit_grid);
+    do_not_optimize(flat_bit_grid.hash());
+  });
+
+  // A tetromino at each of the positions, moved up and left where it would not fit within the grid
+  std::vector<FlatBitGrid<Width, Height>> tetromino_masks(positions.size());
+
+  for (std::size_t i{0}; i < positions.size(); ++i) {
+    const auto& tetromino{FIXED_TETROMINOES[i % NUM_FIXED_TETROMINOES]};
+    Position anchor{
+        std::min(positions[i].x, Width - tetromino.width),
+        std::min(positions[i].y, Height - tetromino.height)
+    };
+
+    for (auto piece : tetromino.pieces) {
+      tetromino_masks[i].set({anchor.x + piece.x, anchor.y + piece.y});
+    }
+  }
+
+  // Word operations of a whole grid with a tetromino mask. Unlike `Grid::place()` (only timed as
+  // part of `Grid::successor()`), they do not update the heuristic or the Zobrist hash
+  auto free_positions{FlatBitGrid<Width, Height>::filled().andnot(flat_bit_grid)};
+
+  run_micro(
+      options,
+      "FlatBitGrid<" + dimensions + ">::operator| (tetromino mask)",
+      [&](std::size_t i) { do_not_optimize(flat_bit_grid | tetromino_masks[i & POSITION_MASK]); }
+  );
+  run_micro(
+      options,
+      "FlatBitGrid<" + dimensions + ">::andnot (tetromino mask)",
+      [&](std::size_t i) {
+        do_not_optimize(free_positions.andnot(tetromino_masks[i & POSITION_MASK]));
+      }
+  );
+
+  auto problem{benchmark_problem<Width, Height>()};
+
+  if (problem.is_target_enclosed()) {
+    return;
+  }
+
+  // A grid a few tetrominoes into a search, and the grids generated around it
+  Grid<Width, Height> grid{problem};
+
+  for (int i{0}; i < 6; ++i) {
+    auto moves{grid.moves()};
+    grid = grid.successor(moves[moves.size() / 2]);
+  }
+
+  auto moves{grid.moves()};
+  std::vector<Grid<Width, Height>> grids{grid};
+
+  for (std::size_t i{0}; i < grids.size() && grids.size() < 4096; ++i) {
+    for (const auto& successor : grids[i].successors()) {
+      grids.push_back(successor);
+    }
+  }
+
+  run_micro(options, "Grid<" + dimensions + ">::successor", [&](std::size_t i) {
+    do_not_optimize(grid.successor(moves[i % moves.size()]));
+  });
+  run_micro(options, "Grid<" + dimensions + ">::moves", [&](std::size_t) {
+    do_not_optimize(grid.moves());
+  });
+  run_micro(options, "Grid<" + dimensions + ">::successors", [&](std::size_t) {
+    do_not_optimize(grid.successors());
+  });
+
+  // Grids generated more than once are only inserted once
+  ClosedSet<Width, Height> closed_set{grids.size()};
+
+  for (const auto& other : grids) {
+    closed_set.insert(other.placements(), other.hash());
+  }
+
+  run_micro(
+      options,
+      "ClosedSet<" + dimensions + ">::insert (new)",
+      [&](std::size_t) {
+        ClosedSet<Width, Height> new_closed_set{grids.size()};
+
+        for (const auto& other : grids) {
+          do_not_optimize(new_closed_set.insert(other.placements(), other.hash()));
+        }
+      },
+      grids.size()
+  );
+  run_micro(options, "ClosedSet<" + dimensions + ">::insert (present)", [&](std::size_t i) {
+    const auto& other{grids[i % grids.size()]};
+    do_not_optimize(closed_set.insert(other.placements(), other.hash()));
+  });
+}
+
+/**
+ * Solves each input file with `astar()` repeatedly until at least `options.min_time_secs` have
+ * passed, then writes a JSON result line with its mean wall time, rate of generated nodes, and the
+ * peak memory of the process so far.
+ */
+void run_solve_benchmarks(const BenchmarkOptions& options) {
+  for (const auto& filename : collect_puzzle_files(options.paths)) {
+    if (!is_selected(options, "solve " + filename)) {
+      continue;
+    }
+
+    auto name{filename};
+
+    if (!options.base_dir.empty()) {
+      name = std::filesystem::path{filename}.lexically_relative(options.base_dir).generic_string();
+    }
+
+    std::cout << "{\"benchmark\":\"solve\",\"file\":" << to_json_string(name);
+
+    AstarParams params{};
+
+    if (!read_astar_params(filename, params)) {
+      std::cout << ",\"status\":\"invalid\"}\n";
+      continue;
+    }
+
+    AstarResult result{};
+    int num_runs{0};
+    double elapsed_secs{0.0};
+    auto start_time{std::chrono::steady_clock::now()};
+
+    do {
+      result = astar(params);
+      ++num_runs;
+      elapsed_secs = seconds_since(start_time);
+    } while (elapsed_secs < options.min_time_secs);
+
+    auto wall_secs{elapsed_secs / num_runs};
+    const auto& stats{result.stats};
+
+    std::cout << ",\"status\":" << (result.is_solved ? "\"solved\"" : "\"unsolvable\"")
+              << ",\"cost\":" << result.cost << ",\"expanded\":" << stats.expanded
+              << ",\"generated\":" << stats.generated << ",\"runs\":" << num_runs
+              << ",\"wall_secs\":" << std::fixed << std::setprecision(6) << wall_secs
+              << ",\"nodes_per_sec\":" << std::setprecision(0) << stats.generated / wall_secs
+              << std::defaultfloat << ",\"peak_rss_bytes\":";
+
+    if (auto rss{peak_rss_bytes()}) {
+      std::cout << *rss << "}\n";
+    } else {
+      std::cout << "null}\n";
+    }
+  }
+}
+
+void print_usage() {
+  std::cout << "Usage:\n";
+  std::cout << "  tetromino_astar_benchmark [--min-time <seconds>] [--filter <text>] "
+               "[<input_file.txt | directory>...]\n";
+}
+}
+
+int main(int argc, char* argv[]) {
+  BenchmarkOptions options{};
+
+  for (int i{1}; i < argc; ++i) {
+    std::string_view arg{argv[i]};
+
+    if (arg == "--min-time" && i + 1 < argc) {
+      options.min_time_secs = std::atof(argv[++i]);
+    } else if (arg == "--filter" && i + 1 < argc) {
+      options.filter = argv[++i];
+    } else if (arg.starts_with("--")) {
+      print_usage();
+      return EXIT_FAILURE;
+    } else {
+      options.paths.emplace_back(arg);
+    }
+  }
+
+  if (options.paths.empty()) {
+    options.paths.emplace_back(TETROMINO_ASTAR_TESTS_DIR);
+    options.base_dir = std::filesystem::path{TETROMINO_ASTAR_TESTS_DIR}.parent_path().string();
+  }
+
+  // Solves run first, so that the peak memory reported with each is not that of the benchmarks
+  // below
+  run_solve_benchmarks(options);
+  run_grid_benchmarks<16, 16>(options);
+  run_grid_benchmarks<128, 128>(options);
+
+  // Peak memory of the whole run
+  std::cout << "{\"benchmark\":\"process\",\"peak_rss_bytes\":";
+
+  if (auto rss{peak_rss_bytes()}) {
+    std::cout << *rss << "}\n";
+  } else {
+    std::cout << "null}\n";
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,90 @@
+#ifndef BITSTATE_SET_H
+#define BITSTATE_SET_H
+
+#include "FlatBitGrid.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Represents a lossy closed set of an A* search with tetromino pieces on a `Width`x`Height` grid,
+ * with the same interface as `ClosedSet`, which stores a few bits per grid state rather than its
+ * placements (i.e., a Bloom filter, or bitstate hashing with more than 1 hash).
+ *
+ * Each grid state sets `num_hashes` bits of a fixed bit array, chosen by 2 independent hashes of
+ * its placements and variant (a mix of its Zobrist hash, and a multiplicative hash of its
+ * placement words) combined by double hashing. A grid state is considered present if all of its
+ * bits are set, so a new grid state is occasionally reported as present (a false positive), and
+ * lost to the search. Its memory never grows, however many grid states are inserted.
+ *
+ * Only compiled for the dimensions listed in `GridDimensions.h`.
+ */
+template <int Width, int Height>
+class BitstateSet {
+public:
+  using FlatBitGrid = ::FlatBitGrid<Width, Height>;
+
+  /**
+   * Constructs an empty set of `num_bits` bits (rounded down to a power of 2, and at least 64),
+   * setting `num_hashes` bits per entry (at least 1). Entries hash their variant if `has_variants`
+   * is `true`, otherwise variants are ignored.
+   */
+  BitstateSet(std::size_t num_bits, int num_hashes, bool has_variants = false);
+
+  /**
+   * Inserts `placements` with variant `variant`, whose combined hash is `hash` (see
+   * `Grid::hash()`), if not already (apparently) present. Returns `true` if it was inserted,
+   * otherwise `false`.
+   */
+  bool insert(const FlatBitGrid& placements, std::size_t hash, std::uint32_t variant = 0);
+
+  /**
+   * Hints that `insert()` will soon be called with Zobrist hash `hash`, so that the word holding
+   * its first bit may be fetched in the meantime.
+   */
+  void prefetch(std::size_t hash) const;
+
+  /**
+   * Returns the number of entries inserted.
+   */
+  std::size_t size() const;
+
+  std::size_t memory_bytes() const;
+
+  /**
+   * Returns the estimated fraction of new grid states that were reported as present, and so lost.
+   *
+   * A new grid state is reported as present with probability p = (set bits / bits)^`num_hashes`
+   * at the time, so each one inserted stands for 1 / (1 - p) new grid states, of which p / (1 - p)
+   * are expected to have been lost.
+   */
+  double false_positive_rate() const;
+
+private:
+  using Word = std::uint64_t;
+
+  static constexpr int WORD_BITS{64};
+
+  std::vector<Word> m_words;
+  // Number of bits minus 1, where the number of bits is a power of 2
+  std::size_t m_mask;
+  int m_num_hashes;
+  bool m_has_variants;
+  std::size_t m_size{0};
+  std::size_t m_num_set_bits{0};
+  // Expected number of new grid states lost so far
+  double m_expected_lost{0.0};
+
+  /**
+   * Returns the index of the first bit of an entry with Zobrist hash `hash`.
+   */
+  std::size_t first_bit(std::size_t hash) const;
+
+  /**
+   * Returns the (odd) step between the bits of an entry with placements `placements` and variant
+   * `variant`.
+   */
+  static std::size_t step(const FlatBitGrid& placements, std::uint32_t variant);
+};
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef CLOSED_SET_H
+#define CLOSED_SET_H
+
+#include "FlatBitGrid.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * Represents the closed set of an A* search with tetromino pieces on a `Width`x`Height` grid (i.e.,
+ * the set of grid states that have been generated).
+ *
+ * Only the placement bit grid of each grid state is stored, as its raw words, densely packed in
+ * fixed-size chunks in order of insertion. The first chunk starts small and doubles as it fills, so
+ * that a small set does not hold a whole chunk. Entries are found through an open-addressing hash
+ * table with Robin Hood linear probing, whose 8-byte slots hold a 32-bit tag taken from the
+ * entry's Zobrist hash (locating the slot that the entry would ideally occupy) and the index of
+ * the entry's words. A probe therefore scans compact slots, and only compares the placement words
+ * of entries with an equal tag. The table doubles in size when it is 7/8 full, reinserting slots
+ * by tag without rehashing or moving entries. Erasing an entry shifts the slots after it back by
+ * 1, and its words are reused by the next entry inserted.
+ *
+ * Optionally, each entry also holds a 32-bit variant, which tells apart grid states with equal
+ * placements (see `Grid::variant()`).
+ *
+ * Only compiled for the dimensions listed in `GridDimensions.h`.
+ */
+template <int Width, int Height>
+class ClosedSet {
+public:
+  using FlatBitGrid = ::FlatBitGrid<Width, Height>;
+  using Word = typename FlatBitGrid::Word;
+
+  /**
+   * Constructs an empty set, allocating enough memory to hold `capacity` entries before growing.
+   * Entries hold a variant if `has_variants` is `true`, otherwise variants are ignored.
+   */
+  explicit ClosedSet(std::size_t capacity, bool has_variants = false);
+
+  /**
+   * Inserts `placements` with variant `variant`, whose combined hash is `hash` (see
+   * `Grid::hash()`), if not already present. Returns `true` if it was inserted, otherwise `false`.
+   */
+  bool insert(const FlatBitGrid& placements, std::size_t hash, std::uint32_t variant = 0);
+
+  /**
+   * Erases `placements` with variant `variant`, whose combined hash is `hash`, if present. Returns
+   * `true` if it was erased, otherwise `false`. Memory is kept for later insertions.
+   */
+  bool erase(const FlatBitGrid& placements, std::size_t hash, std::uint32_t variant = 0);
+
+  /**
+   * Hints that `insert()` will soon be called with Zobrist hash `hash`, so that the slot it probes
+   * first may be fetched in the meantime.
+   */
+  void prefetch(std::size_t hash) const;
+
+  std::size_t size() const;
+
+  /**
+   * Returns the number of entries that can be held before the table grows.
+   */
+  std::size_t capacity() const;
+
+  /**
+   * Returns the number of bytes allocated for the table and entries.
+   */
+  std::size_t memory_bytes() const;
+
+  /**
+   * Returns the number of bytes that inserting an entry not already present would allocate (i.e.,
+   * to grow the table, or for a new chunk of entries). While the table grows, its old slots are
+   * also held until every slot has been reinserted.
+   */
+  std::size_t insertion_bytes() const;
+
+private:
+  static constexpr int NUM_WORDS{FlatBitGrid::NUM_WORDS};
+
+  // Number of entries per chunk is a power of 2, so that indices split into chunk and offset by
+  // shifting
+  static constexpr int CHUNK_SHIFT{12};
+  static constexpr std::size_t CHUNK_SIZE{std::size_t{1} << CHUNK_SHIFT};
+  // Number of entries the first chunk holds at first
+  static constexpr std::size_t MIN_CHUNK_SIZE{16};
+
+  // Tag of empty slots, which is never the tag of an entry
+  static constexpr std::uint32_t EMPTY_TAG{0};
+  // Index of no entry, which ends the list of erased entries
+  static constexpr std::uint32_t NO_ENTRY{std::numeric_limits<std::uint32_t>::max()};
+
+  struct Slot {
+    std::uint32_t tag{EMPTY_TAG};
+    // Index of the entry (see `entry()`)
+    std::uint32_t entry{0};
+  };
+
+  std::vector<Slot> m_slots{};
+  // Placement words of each entry, `NUM_WORDS` per entry and `CHUNK_SIZE` entries per chunk
+  std::vector<std::vector<Word>> m_entry_chunks{};
+  // Variant of each entry, `CHUNK_SIZE` entries per chunk, if `m_has_variants` is `true`
+  std::vector<std::vector<std::uint32_t>> m_variant_chunks{};
+  bool m_has_variants;
+  // Number of slots minus 1, where the number of slots is a power of 2
+  std::size_t m_mask{0};
+  std::size_t m_size{0};
+  // Number of entries that have been allocated, including erased entries
+  std::size_t m_num_entries{0};
+  // Index of the most recently erased entry not yet reused, whose first word holds the index of
+  // the one erased before it, or `NO_ENTRY` if none
+  std::uint32_t m_erased_entry{NO_ENTRY};
+
+  static std::uint32_t tag(std::size_t hash);
+
+  /**
+   * Returns the placement words of entry `index`.
+   */
+  const Word* entry(std::uint32_t index) const;
+  Word* entry(std::uint32_t index);
+
+  /**
+   * Returns the variant of entry `index`.
+   */
+  std::uint32_t variant(std::uint32_t index) const;
+
+  /**
+   * Returns the number of entries that the last chunk must grow to hold, or a new chunk must hold,
+   * to fit 1 more entry, or 0 if the last chunk has room for it.
+   */
+  std::size_t grown_chunk_size() const;
+
+  /**
+   * Returns the number of entries allocated in chunks.
+   */
+  std::size_t allocated_entries() const;
+
+  /**
+   * Places `slot` in the table, starting from its ideal slot. If `placements` is not null, returns
+   * `false` (without placing it) if an entry equal to `placements` with variant `variant` is
+   * already present. Otherwise returns `true`.
+   */
+  bool place(Slot slot, const FlatBitGrid* placements, std::uint32_t variant = 0);
+
+  /**
+   * Reallocates the table with `num_slots` slots (a power of 2), reinserting all slots.
+   */
+  void rehash(std::size_t num_slots);
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef COMPACT_NODE_H
+#define COMPACT_NODE_H
+
+#include "GridDimensions.h"
+#include "Node.h"
+#include "Tetromino.h"
+#include <cstdint>
+
+/**
+ * Represents a search node for A* search with tetromino pieces by the move that leads to its grid
+ * from its parent's grid, rather than by the grid itself, which is rebuilt only for nodes that
+ * are expanded (see `CompactNodeStore`).
+ *
+ * Holds the id of its parent, the move (tetromino and anchor position), and f, in 12 bytes
+ * regardless of the grid dimensions.
+ */
+class CompactNode {
+public:
+  CompactNode(NodeId parent, Move move, int f);
+
+  /**
+   * Returns the id of the node's parent, or `NO_NODE` if the node is a root node.
+   */
+  NodeId parent() const;
+
+  /**
+   * Returns the move that leads to the node's grid from its parent's grid, which is meaningless
+   * for a root node.
+   */
+  Move move() const;
+
+  /**
+   * Returns the node's f, as ordered by the search (e.g., weighted, or raised by the flood-fill
+   * heuristic).
+   */
+  int f() const;
+
+private:
+  static_assert(MAX_GRID_WIDTH <= 256 && MAX_GRID_HEIGHT <= 256);
+  static_assert(NUM_FIXED_TETROMINOES <= 256);
+
+  NodeId m_parent;
+  int m_f;
+  std::uint8_t m_anchor_x;
+  std::uint8_t m_anchor_y;
+  std::uint8_t m_tetromino;
+};
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef COMPACT_NODE_STORE_H
+#define COMPACT_NODE_STORE_H
+
+#include "CompactNode.h"
+#include "Grid.h"
+#include "Node.h"
+#include "Position.h"
+#include "Tetromino.h"
+#include <array>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+/**
+ * Owns the compact nodes (see `CompactNode`) of an A* search with tetromino pieces on a
+ * `Width`x`Height` grid, which refer to each other by id, and rebuilds their grids on demand.
+ *
+ * Nodes are stored in fixed-size chunks, like `NodeStore`, so adding a node never moves existing
+ * nodes. A node's grid is rebuilt by replaying the moves along the path to it from the root grid
+ * given on construction, so it takes time linear in the node's depth.
+ *
+ * Only compiled for the dimensions listed in `GridDimensions.h`.
+ */
+template <int Width, int Height>
+class CompactNodeStore {
+public:
+  using Grid = ::Grid<Width, Height>;
+
+  // Number of nodes per chunk is a power of 2, so that ids split into chunk and offset by shifting
+  static constexpr int CHUNK_SHIFT{14};
+  static constexpr NodeId CHUNK_SIZE{NodeId{1} << CHUNK_SHIFT};
+
+  /**
+   * Constructs an empty store, whose root nodes (i.e., with parent `NO_NODE`) have grid `root`.
+   */
+  explicit CompactNodeStore(const Grid& root);
+
+  /**
+   * Adds a node whose grid results from `move` on node `parent`'s grid (or is the root grid, if
+   * `parent` is `NO_NODE`), with f `f`, then returns its id.
+   */
+  NodeId add(NodeId parent, Move move, int f);
+
+  const CompactNode& operator[](NodeId id) const;
+
+  std::size_t size() const;
+
+  /**
+   * Returns the grid of node `id`, rebuilt from the root grid.
+   */
+  Grid grid(NodeId id) const;
+
+  /**
+   * Returns the tetrominoes placed along the path from the root node to node `id`, in order.
+   */
+  std::vector<std::array<Position, Tetromino::SIZE>> path(NodeId id) const;
+
+  /**
+   * Displays the board of node `id`'s grid, highlighting the tetromino most recently placed.
+   */
+  void print(std::ostream& out, NodeId id) const;
+
+private:
+  Grid m_root;
+  std::vector<std::vector<CompactNode>> m_chunks{};
+  std::size_t m_size{0};
+
+  /**
+   * Returns the moves along the path from the root node to node `id`, in order.
+   */
+  std::vector<Move> moves(NodeId id) const;
+};
+
+#endif
@@ -0,0 +1,552 @@
+#ifndef FLAT_BIT_GRID_H
+#define FLAT_BIT_GRID_H
+
+#include "Position.h"
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+template <int NumCells>
+std::array<std::size_t, NumCells> make_flat_zobrist_table() {
+  std::mt19937_64 rng{};
+  std::uniform_int_distribution<std::size_t> distribution{
+      std::numeric_limits<std::size_t>::min(), std::numeric_limits<std::size_t>::max()
+  };
+
+  std::array<std::size_t, NumCells> zobrist_table{};
+
+  for (auto& value : zobrist_table) {
+    value = distribution(rng);
+  }
+
+  return zobrist_table;
+}
+
+/**
+ * Returns the words of a row-major `Width`x`Height` bit grid with every position set, except those
+ * in column `excluded_x`.
+ */
+template <int Width, int Height, std::size_t NumWords>
+constexpr std::array<uint64_t, NumWords> make_column_excluded_mask(int excluded_x) {
+  std::array<uint64_t, NumWords> mask{};
+
+  for (int i{0}; i < Width * Height; ++i) {
+    if (i % Width != excluded_x) {
+      mask[i / 64] |= uint64_t{1} << (i % 64);
+    }
+  }
+
+  return mask;
+}
+}
+
+/**
+ * Represents an arbitrarily sized bit grid, stored as a flat array of 64-bit words.
+ *
+ * Bits are stored in row-major order (i.e., position (x, y) has bit index `y * Width + x`, where
+ * bit index `i` is bit `i % 64` of word `i / 64`). This allows whole-grid operations (bitwise
+ * and/or/xor/andnot, shifts, 4-neighbour dilation, popcount, and set bit iteration) to be
+ * implemented with a few word operations rather than per-position loops. Bitwise operations use
+ * SSE2 or AVX2 when available and the number of words allows.
+ *
+ * Since whole-grid operations change many bits at once, a Zobrist hash is not maintained
+ * incrementally. Instead, `hash()` computes it from scratch, and `zobrist()` exposes the Zobrist
+ * value of individual positions so that callers can maintain a hash incrementally.
+ */
+template <int Width, int Height>
+class FlatBitGrid {
+  static_assert(Width > 0);
+  static_assert(Height > 0);
+
+public:
+  using Word = uint64_t;
+
+  static constexpr int MAX_X{Width};
+  static constexpr int MAX_Y{Height};
+  static constexpr int NUM_CELLS{Width * Height};
+  static constexpr int WORD_BITS{std::numeric_limits<Word>::digits};
+  static constexpr int NUM_WORDS{(NUM_CELLS + (WORD_BITS - 1)) / WORD_BITS};
+
+  constexpr FlatBitGrid() = default;
+  FlatBitGrid(const std::vector<Position>& positions_to_set);
+
+  /**
+   * Returns a bit grid with every position set.
+   */
+  static constexpr FlatBitGrid filled();
+
+  /**
+   * Returns a bit grid with every position in the rectangle with top-left corner (x=`x`, y=`y`),
+   * width `width`, and height `height` set.
+   */
+  static constexpr FlatBitGrid rectangle(int x, int y, int width, int height);
+
+  /**
+   * Returns the bit index of position `pos` (i.e., `pos.y * Width + pos.x`).
+   */
+  static constexpr int index(Position pos);
+
+  /**
+   * Returns the position with bit index `index`.
+   */
+  static constexpr Position position(int index);
+
+  /**
+   * Returns the Zobrist value of position `pos`, such that the Zobrist hash of a bit grid is the
+   * xor of the Zobrist values of all its set positions.
+   */
+  static std::size_t zobrist(Position pos);
+
+  constexpr bool operator==(const FlatBitGrid& other) const;
+
+  /**
+   * Returns the Zobrist hash of the bit grid. Runs in time linear to the number of set bits.
+   */
+  std::size_t hash() const;
+
+  /**
+   * Sets the bit at position `pos` to 1.
+   */
+  constexpr void set(Position pos);
+
+  /**
+   * Clears the bit at position `pos` (i.e., sets it to 0).
+   */
+  constexpr void clear(Position pos);
+
+  /**
+   * Returns `true` if the bit at position `pos` is set (i.e., is 1), otherwise returns `false`.
+   */
+  constexpr bool is_set(Position pos) const;
+
+  /**
+   * Returns the `count` bits (fewer than 64) from bit index `index` (above -64) onwards, where bit
+   * `i` of the result is the bit at index `index + i`, and indices outside the grid (including
+   * negative indices) read as 0.
+   */
+  constexpr Word bits(int index, int count) const;
+
+  FlatBitGrid& operator&=(const FlatBitGrid& other);
+  FlatBitGrid& operator|=(const FlatBitGrid& other);
+  FlatBitGrid& operator^=(const FlatBitGrid& other);
+  FlatBitGrid operator&(const FlatBitGrid& other) const;
+  FlatBitGrid operator|(const FlatBitGrid& other) const;
+  FlatBitGrid operator^(const FlatBitGrid& other) const;
+
+  /**
+   * Returns the bits set in the calling grid but not in `other` (i.e., `*this & ~other`).
+   */
+  FlatBitGrid andnot(const FlatBitGrid& other) const;
+
+  /**
+   * Returns the calling grid with every bit moved `n` indices lower (i.e., bit `i` of the result
+   * is bit `i + n` of the calling grid). Bits are not masked to rows, so bits may move across rows.
+   */
+  constexpr FlatBitGrid operator>>(int n) const;
+
+  /**
+   * Returns the calling grid with every bit moved `n` indices higher (i.e., bit `i + n` of the
+   * result is bit `i` of the calling grid). Bits are not masked to rows, so bits may move across
+   * rows, but bits moved beyond the last position are discarded.
+   */
+  constexpr FlatBitGrid operator<<(int n) const;
+
+  /**
+   * Returns the 4-neighbour dilation of the calling grid (i.e., every set position, along with
+   * every position directly above, below, left, or right of a set position).
+   */
+  constexpr FlatBitGrid dilated() const;
+
+  /**
+   * Returns `true` if the calling grid and `other` have at least 1 set position in common.
+   */
+  bool intersects(const FlatBitGrid& other) const;
+
+  /**
+   * Returns `true` if no bits are set.
+   */
+  constexpr bool is_empty() const;
+
+  /**
+   * Returns the number of set bits.
+   */
+  constexpr int count() const;
+
+  /**
+   * Calls `function(pos)` for each set position `pos`, in order of increasing bit index.
+   */
+  template <typename Function>
+  constexpr void for_each_set(Function function) const;
+
+  const std::array<Word, NUM_WORDS>& words() const;
+
+private:
+  enum class BitwiseOp { And, Or, Xor, AndNot };
+
+  // Mask of the bits in the last word that represent positions
+  static constexpr Word LAST_WORD_MASK{
+      (NUM_CELLS % WORD_BITS == 0) ? ~Word{0} : (Word{1} << (NUM_CELLS % WORD_BITS)) - 1
+  };
+
+  // Masks used to discard bits that wrapped between rows when moving left or right by 1 index
+  static constexpr std::array<Word, NUM_WORDS> NOT_FIRST_COLUMN_MASK{
+      make_column_excluded_mask<Width, Height, NUM_WORDS>(0)
+  };
+  static constexpr std::array<Word, NUM_WORDS> NOT_LAST_COLUMN_MASK{
+      make_column_excluded_mask<Width, Height, NUM_WORDS>(Width - 1)
+  };
+
+  static inline const std::array<std::size_t, NUM_CELLS> zobrist_table{
+      make_flat_zobrist_table<NUM_CELLS>()
+  };
+
+  std::array<Word, NUM_WORDS> m_words{};
+
+  static constexpr bool is_valid_pos(Position pos);
+
+  /**
+   * Stores `a op b` in `out`, word by word, using SIMD instructions where available.
+   */
+  template <BitwiseOp Op>
+  static void apply(const Word* a, const Word* b, Word* out);
+};
+
+template <int Width, int Height>
+struct FlatBitGridHash {
+  std::size_t operator()(const FlatBitGrid<Width, Height>& grid) const {
+    return grid.hash();
+  }
+};
+
+template <int Width, int Height>
+FlatBitGrid<Width, Height>::FlatBitGrid(const std::vector<Position>& positions_to_set) {
+  assert(positions_to_set.size() < NUM_CELLS); // Assumes no duplicate positions
+
+  for (auto pos : positions_to_set) {
+    assert(is_valid_pos(pos));
+    set(pos);
+  }
+}
+
+template <int Width, int Height>
+constexpr FlatBitGrid<Width, Height> FlatBitGrid<Width, Height>::filled() {
+  FlatBitGrid grid{};
+  grid.m_words.fill(~Word{0});
+  grid.m_words[NUM_WORDS - 1] &= LAST_WORD_MASK;
+  return grid;
+}
+
+template <int Width, int Height>
+constexpr FlatBitGrid<Width, Height>
+FlatBitGrid<Width, Height>::rectangle(int x, int y, int width, int height) {
+  FlatBitGrid grid{};
+
+  for (int j{y}; j < y + height; ++j) {
+    for (int i{x}; i < x + width; ++i) {
+      grid.set({i, j});
+    }
+  }
+
+  return grid;
+}
+
+template <int Width, int Height>
+constexpr int FlatBitGrid<Width, Height>::index(Position pos) {
+  assert(is_valid_pos(pos));
+  return pos.y * Width + pos.x;
+}
+
+template <int Width, int Height>
+constexpr Position FlatBitGrid<Width, Height>::position(int index) {
+  assert(index >= 0 && index < NUM_CELLS);
+  return {index % Width, index / Width};
+}
+
+template <int Width, int Height>
+std::size_t FlatBitGrid<Width, Height>::zobrist(Position pos) {
+  return zobrist_table[index(pos)];
+}
+
+template <int Width, int Height>
+constexpr bool FlatBitGrid<Width, Height>::operator==(const FlatBitGrid& other) const {
+  return m_words == other.m_words;
+}
+
+template <int Width, int Height>
+std::size_t FlatBitGrid<Width, Height>::hash() const {
+  std::size_t zobrist_hash{0};
+
+  for_each_set([&zobrist_hash](Position pos) { zobrist_hash ^= zobrist(pos); });
+
+  return zobrist_hash;
+}
+
+template <int Width, int Height>
+constexpr void FlatBitGrid<Width, Height>::set(Position pos) {
+  int i{index(pos)};
+  m_words[i / WORD_BITS] |= Word{1} << (i % WORD_BITS);
+}
+
+template <int Width, int Height>
+constexpr void FlatBitGrid<Width, Height>::clear(Position pos) {
+  int i{index(pos)};
+  m_words[i / WORD_BITS] &= ~(Word{1} << (i % WORD_BITS));
+}
+
+template <int Width, int Height>
+constexpr bool FlatBitGrid<Width, Height>::is_set(Position pos) const {
+  int i{index(pos)};
+  return (m_words[i / WORD_BITS] >> (i % WORD_BITS)) & 1;
+}
+
+template <int Width, int Height>
+constexpr typename FlatBitGrid<Width, Height>::Word
+FlatBitGrid<Width, Height>::bits(int index, int count) const {
+  assert(index > -WORD_BITS && count > 0 && count < WORD_BITS);
+
+  // Rounds down, so that negative indices fall in word -1
+  int word{(index + WORD_BITS) / WORD_BITS - 1};
+  int bit_shift{index - word * WORD_BITS};
+  auto low{word >= 0 && word < NUM_WORDS ? m_words[word] : Word{0}};
+  auto high{word + 1 >= 0 && word + 1 < NUM_WORDS ? m_words[word + 1] : Word{0}};
+  auto value{low >> bit_shift};
+
+  if (bit_shift != 0) {
+    value |= high << (WORD_BITS - bit_shift);
+  }
+
+  return value & ((Word{1} << count) - 1);
+}
+
+template <int Width, int Height>
+FlatBitGrid<Width, Height>& FlatBitGrid<Width, Height>::operator&=(const FlatBitGrid& other) {
+  apply<BitwiseOp::And>(m_words.data(), other.m_words.data(), m_words.data());
+  return *this;
+}
+
+template <int Width, int Height>
+FlatBitGrid<Width, Height>& FlatBitGrid<Width, Height>::operator|=(const FlatBitGrid& other) {
+  apply<BitwiseOp::Or>(m_words.data(), other.m_words.data(), m_words.data());
+  return *this;
+}
+
+template <int Width, int Height>
+FlatBitGrid<Width, Height>& FlatBitGrid<Width, Height>::operator^=(const FlatBitGrid& other) {
+  apply<BitwiseOp::Xor>(m_words.data(), other.m_words.data(), m_words.data());
+  return *this;
+}
+
+template <int Width, int Height>
+FlatBitGrid<Width, Height> FlatBitGrid<Width, Height>::operator&(const FlatBitGrid& other) const {
+  FlatBitGrid result{};
+  apply<BitwiseOp::And>(m_words.data(), other.m_words.data(), result.m_words.data());
+  return result;
+}
+
+template <int Width, int Height>
+FlatBitGrid<Width, Height> FlatBitGrid<Width, Height>::operator|(const FlatBitGrid& other) const {
+  FlatBitGrid result{};
+  apply<BitwiseOp::Or>(m_words.data(), other.m_words.data(), result.m_words.data());
+  return result;
+}
+
+template <int Width, int Height>
+FlatBitGrid<Width, Height> FlatBitGrid<Width, Height>::operator^(const FlatBitGrid& other) const {
+  FlatBitGrid result{};
+  apply<BitwiseOp::Xor>(m_words.data(), other.m_words.data(), result.m_words.data());
+  return result;
+}
+
+template <int Width, int Height>
+FlatBitGrid<Width, Height> FlatBitGrid<Width, Height>::andnot(const FlatBitGrid& other) const {
+  FlatBitGrid result{};
+  apply<BitwiseOp::AndNot>(m_words.data(), other.m_words.data(), result.m_words.data());
+  return result;
+}
+
+template <int Width, int Height>
+constexpr FlatBitGrid<Width, Height> FlatBitGrid<Width, Height>::operator>>(int n) const {
+  assert(n >= 0);
+
+  FlatBitGrid result{};
+  int word_shift{n / WORD_BITS};
+  int bit_shift{n % WORD_BITS};
+
+  for (int i{0}; i + word_shift < NUM_WORDS; ++i) {
+    result.m_words[i] = m_words[i + word_shift] >> bit_shift;
+
+    // Carry the low bits of the next word into the high bits of this word
+    if (bit_shift != 0 && i + word_shift + 1 < NUM_WORDS) {
+      result.m_words[i] |= m_words[i + word_shift + 1] << (WORD_BITS - bit_shift);
+    }
+  }
+
+  return result;
+}
+
+template <int Width, int Height>
+constexpr FlatBitGrid<Width, Height> FlatBitGrid<Width, Height>::operator<<(int n) const {
+  assert(n >= 0);
+
+  FlatBitGrid result{};
+  int word_shift{n / WORD_BITS};
+  int bit_shift{n % WORD_BITS};
+
+  for (int i{NUM_WORDS - 1}; i - word_shift >= 0; --i) {
+    result.m_words[i] = m_words[i - word_shift] << bit_shift;
+
+    // Carry the high bits of the previous word into the low bits of this word
+    if (bit_shift != 0 && i - word_shift - 1 >= 0) {
+      result.m_words[i] |= m_words[i - word_shift - 1] >> (WORD_BITS - bit_shift);
+    }
+  }
+
+  result.m_words[NUM_WORDS - 1] &= LAST_WORD_MASK;
+  return result;
+}
+
+template <int Width, int Height>
+constexpr FlatBitGrid<Width, Height> FlatBitGrid<Width, Height>::dilated() const {
+  FlatBitGrid result{*this};
+  auto right{(*this << 1).m_words};
+  auto left{(*this >> 1).m_words};
+  auto down{(*this << Width).m_words};
+  auto up{(*this >> Width).m_words};
+
+  for (int i{0}; i < NUM_WORDS; ++i) {
+    result.m_words[i] |= (right[i] & NOT_FIRST_COLUMN_MASK[i]) | (left[i] & NOT_LAST_COLUMN_MASK[i])
+                         | down[i] | up[i];
+  }
+
+  return result;
+}
+
+template <int Width, int Height>
+bool FlatBitGrid<Width, Height>::intersects(const FlatBitGrid& other) const {
+  for (int i{0}; i < NUM_WORDS; ++i) {
+    if (m_words[i] & other.m_words[i]) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+template <int Width, int Height>
+constexpr bool FlatBitGrid<Width, Height>::is_empty() const {
+  for (auto word : m_words) {
+    if (word != 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+template <int Width, int Height>
+constexpr int FlatBitGrid<Width, Height>::count() const {
+  int count{0};
+
+  for (auto word : m_words) {
+    count += std::popcount(word);
+  }
+
+  return count;
+}
+
+template <int Width, int Height>
+template <typename Function>
+constexpr void FlatBitGrid<Width, Height>::for_each_set(Function function) const {
+  for (int i{0}; i < NUM_WORDS; ++i) {
+    // Repeatedly take the lowest set bit, then clear it
+    for (auto word{m_words[i]}; word != 0; word &= word - 1) {
+      function(position(i * WORD_BITS + std::countr_zero(word)));
+    }
+  }
+}
+
+template <int Width, int Height>
+const std::array<typename FlatBitGrid<Width, Height>::Word, FlatBitGrid<Width, Height>::NUM_WORDS>&
+FlatBitGrid<Width, Height>::words() const {
+  return m_words;
+}
+
+template <int Width, int Height>
+constexpr bool FlatBitGrid<Width, Height>::is_valid_pos(Position pos) {
+  return pos.x >= 0 && pos.x < Width && pos.y >= 0 && pos.y < Height;
+}
+
+template <int Width, int Height>
+template <typename FlatBitGrid<Width, Height>::BitwiseOp Op>
+void FlatBitGrid<Width, Height>::apply(const Word* a, const Word* b, Word* out) {
+  int i{0};
+
+#if defined(__AVX2__)
+  if constexpr (NUM_WORDS % 4 == 0) {
+    for (; i < NUM_WORDS; i += 4) {
+      auto x{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i))};
+      auto y{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i))};
+      __m256i z{};
+
+      if constexpr (Op == BitwiseOp::And) {
+        z = _mm256_and_si256(x, y);
+      } else if constexpr (Op == BitwiseOp::Or) {
+        z = _mm256_or_si256(x, y);
+      } else if constexpr (Op == BitwiseOp::Xor) {
+        z = _mm256_xor_si256(x, y);
+      } else {
+        z = _mm256_andnot_si256(y, x); // Computes ~y & x
+      }
+
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), z);
+    }
+  }
+#endif
+
+#if defined(__SSE2__)
+  if constexpr (NUM_WORDS % 2 == 0) {
+    for (; i < NUM_WORDS; i += 2) {
+      auto x{_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i))};
+      auto y{_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i))};
+      __m128i z{};
+
+      if constexpr (Op == BitwiseOp::And) {
+        z = _mm_and_si128(x, y);
+      } else if constexpr (Op == BitwiseOp::Or) {
+        z = _mm_or_si128(x, y);
+      } else if constexpr (Op == BitwiseOp::Xor) {
+        z = _mm_xor_si128(x, y);
+      } else {
+        z = _mm_andnot_si128(y, x); // Computes ~y & x
+      }
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), z);
+    }
+  }
+#endif
+
+  // Scalar fallback (also handles widths where the number of words is odd)
+  for (; i < NUM_WORDS; ++i) {
+    if constexpr (Op == BitwiseOp::And) {
+      out[i] = a[i] & b[i];
+    } else if constexpr (Op == BitwiseOp::Or) {
+      out[i] = a[i] | b[i];
+    } else if constexpr (Op == BitwiseOp::Xor) {
+      out[i] = a[i] ^ b[i];
+    } else {
+      out[i] = a[i] & ~b[i];
+    }
+  }
+}
+
+#endif
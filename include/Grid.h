@@ -1,77 +1,194 @@
 #ifndef GRID_H
 #define GRID_H
 
-#include "BitGrid.h"
+#include "FlatBitGrid.h"
 #include "Position.h"
+#include "Problem.h"
+#include "Tetromino.h"
+#include <array>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <ostream>
-#include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 /**
- * Represents a 24x16 grid designed for A* search with tetromino pieces.
+ * Heuristics for estimating the cost (in terms of tetromino moves) from a grid to the target
+ * position.
+ */
+enum class Heuristic {
+  // Distance from the nearest placed piece, ignoring the shapes of tetrominoes (see
+  // `Problem::heuristic_value()`)
+  Static,
+  // Distance from the placed pieces through positions that a tetromino can still be placed on,
+  // which also detects grids that can no longer reach the target position (see
+  // `Grid::raise_to_flood_fill_heuristic()`)
+  FloodFill
+};
+
+/**
+ * Rules for which tetrominoes may be placed next on a grid (see `Grid::successors()`).
+ */
+enum class PlacementRule : std::uint8_t {
+  // Adjacent to any placed piece
+  Anywhere,
+  // Adjacent to the most recently placed tetromino (or the start position, if none has been
+  // placed). An optimal solution's tetrominoes always form such a chain, since any tetromino that
+  // is not on the chain from the start position to the target position could be removed
+  Chain
+};
+
+/**
+ * Represents a `Width`x`Height` grid designed for A* search with tetromino pieces.
+ *
+ * Manages the grid state, which consists of positions where a piece (of a tetromino) has been
+ * placed. The start position, the target position, and obstacle positions are stored by the
+ * grid's problem, which is shared by all grids of a search (see `Problem`).
  *
- * Manages the grid state, which consists of the start position, the target position, obstacle
- * positions, and positions where a piece (of a tetromino) has been placed.
- * Before initialising any instances, the static member functions `set_start()`, `set_target()`,
- * `set_obstacles()` should first be called (in any order), followed by
- * `preprocess_heuristic_values()`.
+ * Only compiled for the dimensions listed in `GridDimensions.h`.
  */
+template <int Width, int Height>
 class Grid {
 public:
-  static constexpr int MAX_X{24};
-  static constexpr int MAX_Y{16};
-  static constexpr int TETROMINO_SIZE{4};
-
-  static void set_start(Position pos);
-  static void set_target(Position pos);
-  static void set_obstacles(const BitGrid<MAX_X, MAX_Y>& obstacles);
+  static constexpr int MAX_X{Width};
+  static constexpr int MAX_Y{Height};
+  static constexpr int TETROMINO_SIZE{Tetromino::SIZE};
 
   /**
-   * Calculates the heuristic value of all non-obstacle grid positions, then stores it in
-   * `s_heuristic_values`.
-   *
-   * The heuristic value of a position is equal to the optimal cost (in terms of tetromino moves)
-   * to reach the target position. It is calculated using Dijkstra's algorithm.
+   * Constructs the initial grid of `problem`, where a piece has been placed on the start position,
+   * whose successors follow `placement_rule`, as do theirs. `problem` must outlive the grid and all
+   * grids derived from it.
    */
-  static void preprocess_heuristic_values();
+  explicit Grid(
+      const Problem<Width, Height>& problem,
+      PlacementRule placement_rule = PlacementRule::Anywhere
+  );
 
   /**
-   * Returns `true` if there exists a path (in terms of single cell moves) from the start position
-   * to the target position.
-   *
-   * Dependent on `preprocess_heuristic_values()` having been called beforehand.
+   * Constructs a grid of `problem` where only `move` has been placed, which must cover the start
+   * position (rather than be adjacent to it), with an actual cost of 1. Such grids are the initial
+   * grids of a search backwards from the target position, using the reverse problem (see
+   * `Problem::reversed()`).
    */
-  static bool is_target_enclosed();
-
-  static Position start();
-  static Position target();
-  static const BitGrid<MAX_X, MAX_Y>& obstacles();
+  Grid(const Problem<Width, Height>& problem, Move move);
 
-  Grid();
+  /**
+   * Constructs a grid of `problem` where a piece has been placed on each position set in
+   * `placements` (which must include the start position), with an actual cost of `g`, where
+   * `last_move` (ignored if `g` is 0) was the most recently placed tetromino, and whose successors
+   * follow `placement_rule`. Restores grids stored by their placements alone (see
+   * `external_astar()`).
+   */
+  Grid(
+      const Problem<Width, Height>& problem,
+      const FlatBitGrid<Width, Height>& placements,
+      int g,
+      Move last_move,
+      PlacementRule placement_rule
+  );
   Grid(const Grid& other) = default;
   Grid& operator=(Grid other); // Pass by value to implement copy-and-swap idiom
 
   bool operator==(const Grid& other) const;
   bool operator<(const Grid& other) const;
+
+  /**
+   * Returns the Zobrist hash of the placements, combined with `variant()` if it is not 0.
+   */
   std::size_t hash() const;
 
+  /**
+   * Returns 0, or with `PlacementRule::Chain`, a nonzero value identifying the most recently
+   * placed tetromino, since grid states with equal placements but different chain ends have
+   * different successors. Searches with duplicate detection must tell such grid states apart (see
+   * `ClosedSet`).
+   */
+  std::uint32_t variant() const;
+
+  /**
+   * Returns the actual cost thus far (in terms of tetromino moves).
+   */
+  int g() const;
+
+  /**
+   * Returns the estimated cost to target (in terms of tetromino moves).
+   */
+  int h() const;
+
   /**
    * Returns a vector containing all successor grids.
    *
    * A successor grid is the result of placing a tetromino on the calling grid, such that the
    * tetromino does not overlap with obstacles, and is adjacent to at least one already-placed
    * piece.
+   *
+   * With `PlacementRule::Chain`, the tetromino must be adjacent to the most recently placed
+   * tetromino (or the start position) instead, and the estimated cost to target is that of the
+   * most recently placed tetromino's pieces (which every remaining tetromino extends from).
+   *
+   * With `PlacementRule::Anywhere`, placements that commute with the most recently placed
+   * tetromino are only generated in 1 order: a tetromino that could have been placed before it
+   * (i.e., is adjacent to a piece placed before it) is skipped if its first piece has a lower bit
+   * index than the most recent tetromino's first piece, since placing them the other way round
+   * reaches the same grid state. Every grid state still has a path to it that is never skipped
+   * (the one whose last tetromino has the highest such index, applied recursively), whichever path
+   * reached each grid state first, so searches with duplicate detection remain complete and
+   * optimal.
    */
   std::vector<Grid> successors() const;
 
+  /**
+   * Returns a vector containing the moves that result in each successor grid, in the same order as
+   * `successors()`. Much smaller than the successor grids themselves, so it suits searches that
+   * hold the successors of many grids at once.
+   */
+  std::vector<Move> moves() const;
+
+  /**
+   * Returns the successor grid that results from `move`, which must be one of `moves()`.
+   */
+  Grid successor(Move move) const;
+
+  /**
+   * Returns the estimated cost to target of `successor(move)`, without constructing it.
+   */
+  int successor_h(Move move) const;
+
+  /**
+   * Returns the Zobrist hash of `successor(move)`, without constructing it.
+   */
+  std::size_t successor_hash(Move move) const;
+
   /**
    * Returns `true` if the target position has been reached (i.e., a piece has been placed on the
    * target position), otherwise returns `false`.
    */
   bool is_target_reached() const;
 
+  /**
+   * Returns `true` if it is known that the target position cannot be reached from the grid (i.e.,
+   * the grid is a dead end), otherwise returns `false`.
+   */
+  bool is_target_unreachable() const;
+
+  /**
+   * Raises the estimated cost to target to the flood-fill heuristic value, if it is larger.
+   * Returns `true` if the estimated cost was raised, otherwise `false`.
+   *
+   * The flood-fill heuristic value is the number of positions on a shortest path from the placed
+   * pieces to the target position through coverable positions only (see `coverables()`), divided
+   * by 4 and rounded up, or `Problem::UNREACHABLE` if there is no such path. Every piece placed
+   * from now on must lie on a coverable position, so it is admissible (and consistent), and it is
+   * never lower than the static heuristic value. It is higher where the remaining gaps are too
+   * small or too narrow to place a tetromino, such as around a target position that placements
+   * have nearly enclosed.
+   *
+   * The distance is found by a bit-parallel breadth-first search, which reaches a whole layer of
+   * positions per 4-neighbour dilation. Successor grids take on the raised estimated cost where it
+   * remains admissible for them.
+   */
+  bool raise_to_flood_fill_heuristic();
+
   /**
    * Calculates the difference between the calling grid and `other` grid, assuming `other` differs
    * by exactly 1 tetromino. The difference is returned as an array of 4 positions, representing a
@@ -79,23 +196,28 @@ public:
    */
   std::array<Position, TETROMINO_SIZE> difference(const Grid& other) const;
 
-  const BitGrid<MAX_X, MAX_Y>& placements() const;
+  const FlatBitGrid<Width, Height>& placements() const;
+  const Problem<Width, Height>& problem() const;
 
 private:
-  static inline Position s_start{0, 0};
-  static inline Position s_target{0, 0};
-  static inline BitGrid<MAX_X, MAX_Y> s_obstacles{};
-  static inline std::unordered_map<Position, int, PositionHash> s_heuristic_values{};
+  const Problem<Width, Height>* m_problem;
 
   // Positions where a piece has been placed
-  BitGrid<MAX_X, MAX_Y> m_placements{};
-  // Positions that are adjacent to at least 1 position where a piece has been placed
-  BitGrid<MAX_X, MAX_Y> m_placeables{};
+  FlatBitGrid<Width, Height> m_placements{};
+  // Zobrist hash of `m_placements`, maintained incrementally as pieces are placed
+  std::size_t m_hash{0};
 
   // Actual cost thus far (in terms of tetromino moves)
   int m_g{0};
   // Estimated cost to target (in terms of tetromino moves)
   int m_h;
+  // Index (see `FIXED_TETROMINOES`) and anchor bit index of the most recently placed tetromino, or
+  // -1 and 0 for an initial grid, which determine the placements skipped by `successors()`. Kept
+  // narrow, since every node holds a grid
+  std::int16_t m_last_tetromino{-1};
+  std::int16_t m_last_anchor{0};
+  static_assert(Width * Height - 1 <= std::numeric_limits<std::int16_t>::max());
+  PlacementRule m_placement_rule{PlacementRule::Anywhere};
 
   /**
    * Places a piece at position `pos`.
@@ -103,16 +225,49 @@ private:
   void place(Position pos);
 
   /**
-   * Returns a vector containing all successor grids that result from placing a tetromino on the
-   * calling grid that overlaps position `pos`. `visited` is used for revisited-state checking.
+   * Places `tetromino` with its anchor (i.e., the top-left corner of its bounding box) at position
+   * `anchor`.
+   */
+  void place(const Tetromino& tetromino, Position anchor);
+
+  /**
+   * Returns the positions that are adjacent to at least 1 position where a piece has been placed
+   * (or with `PlacementRule::Chain`, to the most recently placed tetromino or the start position),
+   * excluding obstacle positions and positions where a piece has been placed.
+   *
+   * Derived from `m_placements` by 4-neighbour dilation rather than stored, since it is only needed
+   * when generating successor grids.
+   */
+  FlatBitGrid<Width, Height> placeables() const;
+
+  /**
+   * Returns the positions of the most recently placed tetromino, which must exist.
+   */
+  FlatBitGrid<Width, Height> last_tetromino_positions() const;
+
+  /**
+   * Returns the positions that are neither obstacle positions nor positions where a piece has been
+   * placed.
+   */
+  FlatBitGrid<Width, Height> unoccupied() const;
+
+  /**
+   * Returns the positions that are covered by at least 1 tetromino that fits entirely on
+   * unoccupied positions (see `unoccupied()`), regardless of whether it is adjacent to an
+   * already-placed piece.
+   */
+  FlatBitGrid<Width, Height> coverables() const;
+
+  /**
+   * Calls `fn(tetromino_index, anchor)` for each valid tetromino placement (see `successors()`).
    */
-  std::vector<Grid> successors_from(
-      Position pos, std::unordered_set<BitGrid<MAX_X, MAX_Y>, BitGridHash<MAX_X, MAX_Y>>& visited
-  ) const;
+  template <typename Fn>
+  void for_each_move(Fn fn) const;
 };
 
+template <int Width, int Height>
 struct GridHash {
-  std::size_t operator()(const Grid& grid) const {
+  std::size_t operator()(const Grid<Width, Height>& grid) const {
     return grid.hash();
   }
 };
@@ -0,0 +1,23 @@
+#ifndef GRID_DIMENSIONS_H
+#define GRID_DIMENSIONS_H
+
+/**
+ * Calls macro `X(width, height)` for each grid dimensions that `Grid`, `Node`, and `astar()` are
+ * compiled for, in order of increasing number of cells.
+ *
+ * Boards are solved using the first (i.e., smallest) dimensions they fit within, so that small
+ * boards keep tight fixed-size bit grids. Positions outside the board are treated as obstacles.
+ */
+#define FOR_EACH_GRID_DIMENSIONS(X)                                                               \
+  X(8, 8)                                                                                         \
+  X(16, 16)                                                                                       \
+  X(24, 16)                                                                                       \
+  X(32, 32)                                                                                       \
+  X(64, 64)                                                                                       \
+  X(128, 128)
+
+// Largest grid dimensions that boards can be solved with
+inline constexpr int MAX_GRID_WIDTH{128};
+inline constexpr int MAX_GRID_HEIGHT{128};
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+/**
+ * Represents a lock-free, unbounded queue of values of type `T`, which any number of threads may
+ * push to, and a single thread pops from.
+ *
+ * Pushed values are linked onto an atomic list head with compare-and-swap, and the consumer takes
+ * the whole list at once with a single exchange, so neither side ever waits for the other, and
+ * taken values are never contended. Values are not popped in order of pushing; `pop_all()` returns
+ * them most recently pushed first.
+ */
+template <typename T>
+class MpscQueue {
+public:
+  struct Entry {
+    T value;
+    Entry* next{nullptr};
+  };
+
+  /**
+   * Owns a list of entries taken from the queue, which are deleted along with it.
+   */
+  class Entries {
+  public:
+    explicit Entries(Entry* head)
+        : m_head{head} {}
+
+    Entries(const Entries& other) = delete;
+    Entries& operator=(const Entries& other) = delete;
+
+    ~Entries() {
+      while (m_head != nullptr) {
+        delete std::exchange(m_head, m_head->next);
+      }
+    }
+
+    bool empty() const {
+      return m_head == nullptr;
+    }
+
+    /**
+     * Calls `function(value)` for each value in the list.
+     */
+    template <typename Function>
+    void for_each(Function function) {
+      for (auto* entry{m_head}; entry != nullptr; entry = entry->next) {
+        function(entry->value);
+      }
+    }
+
+  private:
+    Entry* m_head;
+  };
+
+  MpscQueue() = default;
+  MpscQueue(const MpscQueue& other) = delete;
+  MpscQueue& operator=(const MpscQueue& other) = delete;
+
+  ~MpscQueue() {
+    Entries{m_head.exchange(nullptr)};
+  }
+
+  /**
+   * Pushes `value`. May be called by any thread.
+   */
+  void push(T value) {
+    auto* entry{new Entry{std::move(value)}};
+    entry->next = m_head.load(std::memory_order_relaxed);
+
+    while (!m_head.compare_exchange_weak(
+        entry->next, entry, std::memory_order_release, std::memory_order_relaxed
+    )) {
+    }
+  }
+
+  /**
+   * Removes and returns all values pushed so far. Must only be called by the consumer thread.
+   */
+  Entries pop_all() {
+    if (m_head.load(std::memory_order_relaxed) == nullptr) {
+      return Entries{nullptr};
+    }
+
+    return Entries{m_head.exchange(nullptr, std::memory_order_acquire)};
+  }
+
+private:
+  std::atomic<Entry*> m_head{nullptr};
+};
+
+#endif
@@ -2,43 +2,42 @@
 #define NODE_H
 
 #include "Grid.h"
-#include <memory>
-#include <ostream>
-#include <vector>
+#include <cstdint>
+#include <limits>
+
+/**
+ * Index of a node within its `NodeStore`.
+ */
+using NodeId = std::uint32_t;
+
+// Id of the parent of root nodes, which is not the id of any node
+inline constexpr NodeId NO_NODE{std::numeric_limits<NodeId>::max()};
 
 /**
  * Represents a search node for A* search with tetromino pieces.
  *
- * Encapsulates a grid state, and the node's parent to allow for backtracking.
- * Inherits from `std::enable_shared_from_this` to allow for the creation of successor nodes that
- * references their parent. Because of this, nodes must always be created, managed, and referenced
- * via shared pointers.
+ * Encapsulates a grid state, and the id of the node's parent to allow for backtracking. Nodes are
+ * owned by a `NodeStore`, which the parent id refers into.
  */
-class Node : public std::enable_shared_from_this<Node> {
+template <int Width, int Height>
+class Node {
 public:
-  Node() = default;
-  Node(const Grid& grid, const std::shared_ptr<const Node>& parent);
+  using Grid = ::Grid<Width, Height>;
+
+  Node(const Grid& grid, NodeId parent);
 
   bool operator<(const Node& other) const;
 
+  const Grid& grid() const;
+
   /**
-   * Returns a vector containing all successor nodes.
-   *
-   * A successor node encapsulates a successor grid and a reference to its parent (i.e., the calling
-   * node).
-   * The successor grid is the result of validly placing a tetromino on `m_grid` (see
-   * `successors()` in `Grid` for more detail).
+   * Returns the id of the node's parent, or `NO_NODE` if the node is a root node.
    */
-  std::vector<std::shared_ptr<const Node>> successors() const;
-
-  const Grid& grid() const;
-  const std::shared_ptr<const Node>& parent() const;
+  NodeId parent() const;
 
 private:
-  Grid m_grid{};
-  std::shared_ptr<const Node> m_parent{nullptr};
+  Grid m_grid;
+  NodeId m_parent{NO_NODE};
 };
 
-std::ostream& operator<<(std::ostream& out, const Node& node);
-
 #endif
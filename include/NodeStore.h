@@ -0,0 +1,71 @@
+#ifndef NODE_STORE_H
+#define NODE_STORE_H
+
+#include "Grid.h"
+#include "Node.h"
+#include "Position.h"
+#include "Tetromino.h"
+#include <array>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+/**
+ * Owns the nodes of an A* search with tetromino pieces on a `Width`x`Height` grid, which refer to
+ * each other by id rather than by pointer.
+ *
+ * Nodes are stored in fixed-size chunks, each allocated once, so adding a node does not allocate
+ * (except when a new chunk is started), and never moves existing nodes. References to nodes
+ * therefore remain valid until the node is removed. The slots of removed nodes are reused by nodes
+ * added later, so memory is bounded by the most nodes held at once.
+ *
+ * Only compiled for the dimensions listed in `GridDimensions.h`.
+ */
+template <int Width, int Height>
+class NodeStore {
+public:
+  using Grid = ::Grid<Width, Height>;
+  using Node = ::Node<Width, Height>;
+
+  // Number of nodes per chunk is a power of 2, so that ids split into chunk and offset by shifting
+  static constexpr int CHUNK_SHIFT{12};
+  static constexpr NodeId CHUNK_SIZE{NodeId{1} << CHUNK_SHIFT};
+
+  /**
+   * Adds a node encapsulating `grid`, whose parent is node `parent` (or `NO_NODE` for a root
+   * node), then returns its id. `parent` is stored as is, so it may also refer into another store
+   * by some other numbering (see `hda_star()`).
+   */
+  NodeId add(const Grid& grid, NodeId parent);
+
+  /**
+   * Removes node `id`, whose id may then be given to a node added later.
+   */
+  void remove(NodeId id);
+
+  const Node& operator[](NodeId id) const;
+
+  /**
+   * Returns the number of nodes held (i.e., added but not removed).
+   */
+  std::size_t size() const;
+
+  /**
+   * Returns the tetrominoes placed along the path from the root node to node `id`, in order.
+   */
+  std::vector<std::array<Position, Tetromino::SIZE>> path(NodeId id) const;
+
+  /**
+   * Displays the board of node `id`'s grid, highlighting the tetromino most recently placed.
+   */
+  void print(std::ostream& out, NodeId id) const;
+
+private:
+  std::vector<std::vector<Node>> m_chunks{};
+  // Number of slots used, including those of removed nodes
+  std::size_t m_num_slots{0};
+  // Ids of removed nodes, whose slots are reused before new slots are used
+  std::vector<NodeId> m_free_ids{};
+};
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef OPEN_LIST_H
+#define OPEN_LIST_H
+
+#include "Node.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * Policies for choosing between nodes of equal f in the open list.
+ */
+enum class TieBreaking {
+  // Most recently added first
+  Lifo,
+  // Least recently added first
+  Fifo,
+  // Highest g (i.e., lowest h) first, then most recently added first
+  DeepestFirst,
+  // Lowest g (i.e., highest h) first, then most recently added first
+  ShallowestFirst
+};
+
+/**
+ * Represents the open list of an A* search, holding node ids ordered by f (lowest first), with
+ * ties broken by a `TieBreaking` policy.
+ *
+ * Since f and g are small non-negative integers (bounded by the board size), nodes are kept in a
+ * bucket for each f, which is split into a sub-bucket for each g. Adding a node and removing the
+ * best node take amortised constant time, other than skipping empty buckets as the lowest f rises.
+ * The lowest f is kept up to date, so that it can be read without removing a node.
+ */
+class OpenList {
+public:
+  explicit OpenList(TieBreaking tie_breaking);
+
+  /**
+   * Adds node `id` with cost `f` and actual cost `g`, where `0 <= g <= f`.
+   */
+  void push(NodeId id, int f, int g);
+
+  /**
+   * Removes and returns the id of the best node. The open list must not be empty.
+   */
+  NodeId pop();
+
+  bool empty() const;
+  std::size_t size() const;
+
+  /**
+   * Returns the lowest f of any node. The open list must not be empty.
+   */
+  int min_f() const;
+
+private:
+  struct SubBucket {
+    std::vector<NodeId> ids{};
+    // Index of the first id not yet removed (only used by `TieBreaking::Fifo`)
+    std::size_t head{0};
+  };
+
+  struct Bucket {
+    // Sub-bucket of each g, or only sub-bucket 0 if g does not break ties
+    std::vector<SubBucket> sub_buckets{};
+    std::size_t size{0};
+    // Index of the sub-bucket to remove from next, if `size` is not 0
+    int best_sub_bucket{0};
+  };
+
+  TieBreaking m_tie_breaking;
+
+  // Bucket of each f
+  std::vector<Bucket> m_buckets{};
+  // Lowest f of any node, if the open list is not empty
+  int m_min_f{0};
+  std::size_t m_size{0};
+
+  /**
+   * Returns `true` if nodes in sub-bucket `a` are preferred over nodes in sub-bucket `b`.
+   */
+  bool is_preferred(int a, int b) const;
+};
+
+#endif
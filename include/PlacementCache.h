@@ -0,0 +1,108 @@
+#ifndef PLACEMENT_CACHE_H
+#define PLACEMENT_CACHE_H
+
+#include "Tetromino.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Represents a cache of the tetromino placements that cover a position, keyed by its neighbourhood
+ * (i.e., which positions near it are free).
+ *
+ * A tetromino that covers a position lies entirely within 3 positions of it (in Manhattan
+ * distance), so whether each of the 76 such placements (each fixed tetromino, with each of its 4
+ * pieces on the position) fits depends only on the 25 positions of that diamond. Neighbourhoods
+ * are stored as the free positions of the 7x7 square around the position, in row-major order,
+ * where positions outside the diamond are always clear, so that they can be taken from a bit grid
+ * a row at a time (see `Grid::successors()`). The cache is direct-mapped, holding 1 neighbourhood
+ * per entry, and independent of grid dimensions and problems, since a neighbourhood alone
+ * determines its placements.
+ *
+ * Each thread has its own cache (see `local()`), so searches running concurrently on different
+ * threads never share entries and need no synchronisation.
+ */
+class PlacementCache {
+public:
+  // Number of positions between a position and the furthest position of its neighbourhood
+  static constexpr int RADIUS{3};
+  // Width and height of the square holding a neighbourhood
+  static constexpr int SPAN{2 * RADIUS + 1};
+  static constexpr int NUM_PLACEMENTS{NUM_FIXED_TETROMINOES * Tetromino::SIZE};
+
+  /**
+   * Set of placements covering a position, where placement `tetromino * 4 + piece` (i.e.,
+   * `FIXED_TETROMINOES[tetromino]` with `pieces[piece]` on the position) is bit `p % 64` of word
+   * `p / 64`.
+   */
+  using Placements = std::array<std::uint64_t, (NUM_PLACEMENTS + 63) / 64>;
+
+  /**
+   * Lookups made of a cache, and how many were answered without computing placements.
+   */
+  struct Stats {
+    std::uint64_t lookups{0};
+    std::uint64_t hits{0};
+
+    Stats& operator+=(const Stats& other) {
+      lookups += other.lookups;
+      hits += other.hits;
+      return *this;
+    }
+
+    Stats operator-(const Stats& other) const {
+      return {lookups - other.lookups, hits - other.hits};
+    }
+
+    double hit_rate() const {
+      return lookups > 0 ? static_cast<double>(hits) / static_cast<double>(lookups) : 0.0;
+    }
+  };
+
+  // Positions of each row of the 7x7 square (as bits of increasing x) that lie within the diamond
+  static constexpr std::array<std::uint64_t, SPAN> ROW_MASKS{
+      0b0001000, 0b0011100, 0b0111110, 0b1111111, 0b0111110, 0b0011100, 0b0001000
+  };
+
+  /**
+   * Constructs an empty cache of `num_entries` entries (rounded down to a power of 2, and at
+   * least 1).
+   */
+  explicit PlacementCache(std::size_t num_entries);
+
+  /**
+   * Returns the calling thread's cache, constructing it on first use.
+   */
+  static PlacementCache& local();
+
+  /**
+   * Returns the placements that fit within neighbourhood `neighbourhood`, whose bit
+   * `(dy + RADIUS) * SPAN + (dx + RADIUS)` is set if the position offset by (`dx`, `dy`) is free,
+   * for positions within the diamond only. The centre must be free.
+   */
+  const Placements& placements(std::uint64_t neighbourhood);
+
+  const Stats& stats() const;
+
+private:
+  struct Entry {
+    // Neighbourhood of the entry, or `EMPTY` if none
+    std::uint64_t neighbourhood;
+    Placements placements;
+  };
+
+  // Never a neighbourhood, since bits beyond the 7x7 square are always clear
+  static constexpr std::uint64_t EMPTY{~std::uint64_t{0}};
+
+  std::vector<Entry> m_entries;
+  int m_shift;
+  Stats m_stats{};
+
+  /**
+   * Returns the placements that fit within `neighbourhood`, computed from scratch.
+   */
+  static Placements compute(std::uint64_t neighbourhood);
+};
+
+#endif
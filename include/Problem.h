@@ -0,0 +1,86 @@
+#ifndef PROBLEM_H
+#define PROBLEM_H
+
+#include "FlatBitGrid.h"
+#include "Position.h"
+#include <limits>
+#include <vector>
+
+/**
+ * Represents a problem for A* search with tetromino pieces on a `Width`x`Height` grid.
+ *
+ * Stores the start position, the target position, obstacle positions, the size of the board being
+ * solved, and the heuristic value of every position. A problem is immutable once constructed, so
+ * it may be shared by any number of grids and searches, including searches running concurrently
+ * on different threads, without synchronisation. Grids reference their problem, so a problem must
+ * outlive all grids that reference it.
+ *
+ * Only compiled for the dimensions listed in `GridDimensions.h`.
+ */
+template <int Width, int Height>
+class Problem {
+public:
+  static constexpr int MAX_X{Width};
+  static constexpr int MAX_Y{Height};
+
+  // Heuristic value of positions from which the target position cannot be reached
+  static constexpr int UNREACHABLE{std::numeric_limits<int>::max()};
+
+  /**
+   * Constructs a problem on a board of size `board_width`x`board_height`, which must fit within
+   * the grid. Positions outside the board are treated as obstacles.
+   *
+   * Calculates the heuristic value of all positions, which is equal to the optimal cost (in terms
+   * of tetromino moves) to reach the target position. It is calculated using Dijkstra's algorithm.
+   */
+  Problem(
+      Position start,
+      Position target,
+      const std::vector<Position>& obstacles,
+      int board_width = Width,
+      int board_height = Height
+  );
+
+  Position start() const;
+  Position target() const;
+  const FlatBitGrid<Width, Height>& obstacles() const;
+  int board_width() const;
+  int board_height() const;
+
+  /**
+   * Returns the heuristic value of position `pos`, or `UNREACHABLE` if there is no path (in terms
+   * of single cell moves) from `pos` to the target position.
+   */
+  int heuristic_value(Position pos) const;
+
+  /**
+   * Returns `true` if there does not exist a path (in terms of single cell moves) from the start
+   * position to the target position.
+   */
+  bool is_target_enclosed() const;
+
+  /**
+   * Returns the reverse of the problem, for searching backwards from the target position. Its
+   * start position is the target position, and its target position is the start position, which
+   * is also an obstacle position. Its target position is reached by placing a piece adjacent to
+   * it (rather than on it), so heuristic values are reduced accordingly. The problem must not
+   * itself be a reverse problem.
+   */
+  Problem reversed() const;
+
+private:
+  Position m_start{};
+  Position m_target{};
+  FlatBitGrid<Width, Height> m_obstacles{};
+  int m_board_width{Width};
+  int m_board_height{Height};
+  // `true` if the problem is the reverse of another (see `reversed()`)
+  bool m_is_reversed{false};
+
+  // Heuristic value of each position, indexed by `FlatBitGrid::index()`
+  std::vector<int> m_heuristic_values{};
+
+  void preprocess_heuristic_values();
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef TETROMINO_H
+#define TETROMINO_H
+
+#include "Position.h"
+#include <array>
+
+/**
+ * Represents a fixed tetromino (i.e., a tetromino in a specific orientation).
+ *
+ * The positions of its 4 pieces are relative to the top-left corner of its bounding box, which is
+ * referred to as the tetromino's anchor. For example, the horizontal I tetromino has pieces
+ * (x=0, y=0), (x=1, y=0), (x=2, y=0), and (x=3, y=0), with a width of 4 and a height of 1.
+ */
+struct Tetromino {
+  static constexpr int SIZE{4};
+
+  std::array<Position, SIZE> pieces{};
+  int width{0};
+  int height{0};
+};
+
+inline constexpr int NUM_FIXED_TETROMINOES{19};
+
+/**
+ * All 19 fixed tetrominoes (i.e., every distinct rotation of the 7 one-sided tetrominoes).
+ */
+inline constexpr std::array<Tetromino, NUM_FIXED_TETROMINOES> FIXED_TETROMINOES{{
+    // I
+    {{{{0, 0}, {1, 0}, {2, 0}, {3, 0}}}, 4, 1},
+    {{{{0, 0}, {0, 1}, {0, 2}, {0, 3}}}, 1, 4},
+    // O
+    {{{{0, 0}, {1, 0}, {0, 1}, {1, 1}}}, 2, 2},
+    // T
+    {{{{0, 0}, {1, 0}, {2, 0}, {1, 1}}}, 3, 2},
+    {{{{1, 0}, {0, 1}, {1, 1}, {2, 1}}}, 3, 2},
+    {{{{0, 0}, {0, 1}, {1, 1}, {0, 2}}}, 2, 3},
+    {{{{1, 0}, {0, 1}, {1, 1}, {1, 2}}}, 2, 3},
+    // S
+    {{{{1, 0}, {2, 0}, {0, 1}, {1, 1}}}, 3, 2},
+    {{{{0, 0}, {0, 1}, {1, 1}, {1, 2}}}, 2, 3},
+    // Z
+    {{{{0, 0}, {1, 0}, {1, 1}, {2, 1}}}, 3, 2},
+    {{{{1, 0}, {0, 1}, {1, 1}, {0, 2}}}, 2, 3},
+    // L
+    {{{{0, 0}, {0, 1}, {0, 2}, {1, 2}}}, 2, 3},
+    {{{{0, 0}, {1, 0}, {2, 0}, {0, 1}}}, 3, 2},
+    {{{{0, 0}, {1, 0}, {1, 1}, {1, 2}}}, 2, 3},
+    {{{{2, 0}, {0, 1}, {1, 1}, {2, 1}}}, 3, 2},
+    // J
+    {{{{1, 0}, {1, 1}, {0, 2}, {1, 2}}}, 2, 3},
+    {{{{0, 0}, {0, 1}, {1, 1}, {2, 1}}}, 3, 2},
+    {{{{0, 0}, {1, 0}, {0, 1}, {0, 2}}}, 2, 3},
+    {{{{0, 0}, {1, 0}, {2, 0}, {2, 1}}}, 3, 2},
+}};
+
+/**
+ * Represents a tetromino placement: `FIXED_TETROMINOES[tetromino]` placed with its anchor at
+ * position `anchor`.
+ */
+struct Move {
+  int tetromino{0};
+  Position anchor{};
+};
+
+#endif
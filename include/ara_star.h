@@ -0,0 +1,30 @@
+#ifndef ARA_STAR_H
+#define ARA_STAR_H
+
+#include "Problem.h"
+#include "astar.h"
+
+/**
+ * Searches for a path from the start position to the target position, like `astar()`, using
+ * anytime repairing A* (ARA*), which finds a solution quickly, then improves it while time allows.
+ *
+ * Runs a series of weighted A* searches (see `weighted_f()`), beginning with weight
+ * `options.weight` and lowering it by `options.weight_step` after each search, down to 1. Each
+ * search continues from the open list and closed set of the one before it, re-ordered by the new
+ * weight, rather than starting over. Since every grid state has a fixed actual cost (the number of
+ * tetrominoes it contains), a grid state is never reached at a lower cost once generated, so no
+ * grid state is ever expanded twice. Grids that cannot lead to a cheaper solution than the best
+ * found so far are discarded.
+ *
+ * After each search, `options.on_solution` (if not empty) is called with the best solution so far,
+ * and a bound on how far its cost may exceed the optimal cost. The bound is the lower of the
+ * weight and the ratio of its cost to the lowest unweighted f of any open grid. The search ends
+ * once the solution is proven optimal, or once `options.time_limit_secs` (if not 0) has passed, in
+ * which case the best solution so far is returned.
+ *
+ * `options.visualise` is ignored. Only compiled for the dimensions listed in `GridDimensions.h`.
+ */
+template <int Width, int Height>
+AstarResult ara_star(const Problem<Width, Height>& problem, const AstarOptions& options);
+
+#endif
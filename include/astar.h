@@ -1,26 +1,200 @@
 #ifndef ASTAR_H
 #define ASTAR_H
 
+#include "Grid.h"
+#include "GridDimensions.h"
+#include "OpenList.h"
+#include "PlacementCache.h"
 #include "Position.h"
+#include "Problem.h"
+#include "Tetromino.h"
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <ostream>
 #include <string>
+#include <utility>
 #include <vector>
 
 /**
  * Stores the required parameters of `astar()`.
  */
 struct AstarParams {
+  // Board dimensions
+  int width;
+  int height;
   Position start;
   Position target;
   std::vector<Position> obstacles;
 };
 
+/**
+ * Search algorithms that `astar()` may use.
+ */
+enum class Algorithm {
+  // A* search on a single thread
+  Astar,
+  // Hash-distributed A* search on `AstarOptions::num_threads` threads (see `hda_star()`)
+  HdaStar,
+  // Iterative-deepening A* search, in memory independent of the number of nodes (see
+  // `ida_star()`)
+  IdaStar,
+  // A* search that only keeps open nodes, rebuilding the path by recursive sub-searches (see
+  // `frontier_search()`)
+  FrontierSearch,
+  // A* search from both the start position and the target position (see `bidirectional_search()`)
+  Bidirectional,
+  // Anytime repairing A* search, which finds solutions with decreasing weights (see `ara_star()`)
+  AraStar,
+  // Beam search on `AstarOptions::num_threads` threads, which keeps a bounded number of grids per
+  // layer (see `beam_search()`)
+  BeamSearch,
+  // Partial-expansion A* search, which only constructs the successors needed next (see
+  // `pea_star()`)
+  PeaStar,
+  // A* search that keeps its open and closed lists in files on disk (see `external_astar()`)
+  ExternalAstar,
+  // Simplified memory-bounded A* search, which forgets the worst nodes to stay within a memory
+  // limit (see `sma_star()`)
+  SmaStar
+};
+
+struct AstarResult;
+struct MemoryUsage;
+
+/**
+ * Stores the optional parameters of `astar()`.
+ */
+struct AstarOptions {
+  Algorithm algorithm{Algorithm::Astar};
+  // Number of threads used by the search, for algorithms that use more than 1
+  int num_threads{1};
+  // If `true`, each grid expanded during the search is displayed to the console (only supported
+  // by `Algorithm::Astar`)
+  bool visualise{false};
+  Heuristic heuristic{Heuristic::Static};
+  // Where successors may place tetrominoes (see `Grid::successors()`), which all algorithms except
+  // `Algorithm::Bidirectional` support
+  PlacementRule placement_rule{PlacementRule::Anywhere};
+  TieBreaking tie_breaking{TieBreaking::DeepestFirst};
+  // Number of grids the closed set holds before it first grows (see `ClosedSet`)
+  std::size_t closed_set_capacity{std::size_t{1} << 16};
+  // Number of bits of the lossy closed set that `Algorithm::Astar` uses instead of an exact one
+  // (see `BitstateSet`), or 0 for an exact closed set
+  std::size_t bitstate_bits{0};
+  // Number of bits set per grid by the lossy closed set
+  int bitstate_hashes{3};
+  // Number of entries in the transposition table of `Algorithm::IdaStar`, or 0 for none
+  std::size_t transposition_table_size{0};
+  // Weight of h in f (see `weighted_f()`), which is at least 1, used by `Algorithm::Astar` and
+  // `Algorithm::PeaStar`, and as the initial weight of `Algorithm::AraStar`
+  double weight{1.0};
+  // Amount by which `Algorithm::AraStar` lowers the weight after each search
+  double weight_step{0.5};
+  // Wall time after which `Algorithm::AraStar` returns its best solution so far, or 0 for no limit
+  double time_limit_secs{0.0};
+  // If not empty, called by `Algorithm::AraStar` with each solution it finds
+  std::function<void(const AstarResult&)> on_solution{};
+  // Number of grids per layer kept by `Algorithm::BeamSearch`
+  std::size_t beam_width{64};
+  // Memory that `Algorithm::ExternalAstar` may use to buffer and sort grids, and that
+  // `Algorithm::SmaStar` may use for its nodes, open list, and closed set, in bytes
+  std::size_t memory_limit_bytes{std::size_t{256} << 20};
+  // Directory in which `Algorithm::ExternalAstar` creates its spill files, or empty for the
+  // system's temporary directory
+  std::string spill_dir{};
+  // If not empty, called by `Algorithm::SmaStar` with the memory it holds while it searches,
+  // whenever the total has changed by at least `memory_usage_step_bytes` since the last call
+  std::function<void(const MemoryUsage&)> on_memory_usage{};
+  std::size_t memory_usage_step_bytes{std::size_t{1} << 20};
+};
+
+/**
+ * Returns f for a grid with actual cost `g` and estimated cost `h`, where h is weighted by
+ * `weight`. A search that expands grids in order of weighted f finds a solution that costs at most
+ * `weight` times the optimal cost, since h is admissible (rounding down keeps this so).
+ */
+inline int weighted_f(int g, int h, double weight) {
+  return g + static_cast<int>(weight * h);
+}
+
+/**
+ * Node stats for A* search.
+ */
+struct Stats {
+  int expanded{0};
+  int generated{0};
+  int revisited{0};
+  // Nodes from which the target position was found to be unreachable
+  int pruned{0};
+
+  friend std::ostream& operator<<(std::ostream& out, const Stats& stats) {
+    out << "In total,\n";
+    out << stats.expanded << " nodes were expanded,\n";
+    out << stats.generated << " nodes were generated,\n";
+    out << stats.revisited << " nodes were revisited, and\n";
+    out << stats.pruned << " nodes were pruned.\n";
+
+    return out;
+  }
+};
+
+/**
+ * Bytes held by the data structures of a search.
+ */
+struct MemoryUsage {
+  std::size_t node_bytes{0};
+  std::size_t open_list_bytes{0};
+  std::size_t closed_set_bytes{0};
+
+  std::size_t total_bytes() const {
+    return node_bytes + open_list_bytes + closed_set_bytes;
+  }
+};
+
+/**
+ * Stores the outcome of `astar()`.
+ */
+struct AstarResult {
+  // `false` if no solution exists
+  bool is_solved{false};
+  // Cost of the optimal solution (in terms of tetromino moves)
+  int cost{0};
+  Stats stats{};
+  // Wall time of the search
+  double elapsed_secs{0.0};
+  // Tetrominoes placed along the optimal solution, in order
+  std::vector<std::array<Position, Tetromino::SIZE>> path{};
+  // Factor by which `cost` may exceed the optimal cost, which is 1 if the solution is optimal
+  double suboptimality_bound{1.0};
+  // `true` if the search ran out of time (see `AstarOptions::time_limit_secs`)
+  bool is_out_of_time{false};
+  // `true` if no solution was found, but one may exist, since the search discarded grids (see
+  // `Algorithm::BeamSearch` and `AstarOptions::bitstate_bits`)
+  bool is_incomplete{false};
+  // `true` if the search failed to write or read its files (see `Algorithm::ExternalAstar`)
+  bool is_io_error{false};
+  // Estimated fraction of new grids lost to false positives of the lossy closed set (see
+  // `AstarOptions::bitstate_bits`), otherwise 0
+  double false_positive_rate{0.0};
+  // Memory held by the search when it held the most, if accounted for (see `Algorithm::SmaStar`),
+  // otherwise all 0. The memory held meanwhile is reported to `AstarOptions::on_memory_usage`.
+  MemoryUsage peak_memory{};
+  // Lookups made of the placement caches of the threads that generated successors (see
+  // `Grid::successors()`)
+  PlacementCache::Stats placement_cache{};
+};
+
 /**
  * Reads the required parameters for `astar()` from file `filename` and stores them in `params`.
  * Returns `true` if successful, otherwise `false`.
  *
  * The file should be a .txt file, containing a string representation of the initial grid state,
  * where 's' represents the start position, 't' represents the target position, 'o' represents
- * obstacle positions, and '.' represents empty positions. Here is an example of a valid file:
+ * obstacle positions, and '.' represents empty positions. The board may be any rectangle up to
+ * `MAX_GRID_WIDTH`x`MAX_GRID_HEIGHT` (see `GridDimensions.h`), where all lines have equal length.
+ * Here is an example of a valid file:
  * s.......................
  * ........................
  * ........................
@@ -40,15 +214,65 @@ struct AstarParams {
  */
 bool read_astar_params(const std::string& filename, AstarParams& params);
 
+/**
+ * Writes `params` to file `filename` in the format read by `read_astar_params()`. Returns `true` if
+ * successful, otherwise `false`.
+ */
+bool write_astar_params(const std::string& filename, const AstarParams& params);
+
+/**
+ * Calls `function(problem)` and returns its result, where `problem` is the problem described by
+ * `params`, using the smallest grid dimensions listed in `GridDimensions.h` that the board fits
+ * within. The board must fit within `MAX_GRID_WIDTH`x`MAX_GRID_HEIGHT` (as guaranteed by
+ * `read_astar_params()`).
+ */
+template <typename Function>
+decltype(auto) with_problem(const AstarParams& params, Function&& function) {
+#define DISPATCH_PROBLEM(grid_width, grid_height)                                                 \
+  if (params.width <= grid_width && params.height <= grid_height) {                               \
+    return function(Problem<grid_width, grid_height>{                                             \
+        params.start, params.target, params.obstacles, params.width, params.height                \
+    });                                                                                           \
+  }
+  FOR_EACH_GRID_DIMENSIONS(DISPATCH_PROBLEM)
+#undef DISPATCH_PROBLEM
+
+  assert(false && "Board does not fit within any grid dimensions");
+  std::unreachable();
+}
+
 /**
  * Searches for an optimal path from the start position to the target position, avoiding obstacles
- * positions, where moves are limited to placing tetrominos. Once the optimal path is found, an
- * interactive console display allows for move-by-move visualisation of the optimal path found.
+ * positions, where moves are limited to placing tetrominos, using `options.algorithm`.
+ *
+ * If `options.visualise` is `true`, each grid expanded during the search is displayed to the
+ * console. Otherwise, nothing is written to the console.
  *
- * If `visualise` is `true`, each grid expanded during the search is displayed to the console.
+ * Grids are expanded in order of f, using `options.heuristic`, with ties broken by
+ * `options.tie_breaking`. With `Heuristic::FloodFill`, grids from which the target position cannot
+ * be reached are pruned rather than expanded. If `options.weight` is above 1, h is weighted (see
+ * `weighted_f()`), so the solution may not be optimal, but costs at most `options.weight` times the
+ * optimal cost (see `AstarResult::suboptimality_bound`). If `options.bitstate_bits` is above 0,
+ * grids may be lost to false positives of the lossy closed set, so the solution may cost more than
+ * that, or not be found at all.
+ *
+ * All search state is local to the call and `problem` is only read, so searches may run
+ * concurrently on different threads. Only compiled for the dimensions listed in
+ * `GridDimensions.h`.
+ */
+template <int Width, int Height>
+AstarResult astar(const Problem<Width, Height>& problem, const AstarOptions& options = {});
+
+/**
+ * Calls `astar()` with the problem described by `params` (see `with_problem()`).
+ */
+AstarResult astar(const AstarParams& params, const AstarOptions& options = {});
+
+/**
+ * Calls `astar()` with the problem described by `params`, reporting its progress and outcome to
+ * the console. Once the optimal path is found, an interactive console display allows for
+ * move-by-move visualisation of the optimal path found.
  */
-void astar(
-    Position start, Position target, const std::vector<Position>& obstacles, bool visualise = false
-);
+void astar_interactive(const AstarParams& params, const AstarOptions& options = {});
 
 #endif
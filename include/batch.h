@@ -0,0 +1,58 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "astar.h"
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * Returns `str` as a JSON string literal (i.e., quoted, with special characters escaped).
+ */
+std::string to_json_string(const std::string& str);
+
+/**
+ * Returns the puzzle files described by `paths`, where each path to a directory is expanded to the
+ * `.txt` files it directly contains (in order of filename), and every other path is taken to be a
+ * puzzle file.
+ */
+std::vector<std::string> collect_puzzle_files(const std::vector<std::string>& paths);
+
+/**
+ * Reads the paths listed in manifest file `filename` and appends them to `paths`. Returns `true`
+ * if successful, otherwise `false`.
+ *
+ * The manifest lists one path per line, where empty lines and lines beginning with '#' are
+ * ignored. Relative paths are relative to the directory containing the manifest.
+ */
+bool read_manifest(const std::string& filename, std::vector<std::string>& paths);
+
+/**
+ * Solves each puzzle file in `filenames` with `astar()` and `options` on a pool of `num_threads`
+ * threads, without visualisation. Returns the number of puzzles solved.
+ *
+ * Writes one JSON object per line to `out` for each puzzle, in the order of `filenames`, as soon
+ * as it and all puzzles before it are done. For example,
+ * {"file":"tests/1.txt","status":"solved","cost":24,"bound":1,"expanded":24,"generated":532,
+ *  "revisited":0,"pruned":0,"peak_bytes":null,"false_positive_rate":null,"placement_lookups":775,
+ *  "placement_hit_rate":0.833548,"wall_secs":0.001727}
+ * where "status" is "solved", "unsolvable" (the target is enclosed), "out_of_time" (no solution
+ * was found within `options.time_limit_secs`), "not_found" (no solution was found, but one may
+ * exist, see `AstarResult::is_incomplete`), "io_error" (the search failed to write or read its
+ * files, see `AstarResult::is_io_error`), or "invalid" (the file could not be read, or does not
+ * follow the expected format), "cost" and "bound" (see `AstarResult::suboptimality_bound`)
+ * are `null` unless solved, "peak_bytes" is the total of `AstarResult::peak_memory`, or `null`
+ * if the search does not account for its memory, "false_positive_rate" is
+ * `AstarResult::false_positive_rate` with a lossy closed set (see `AstarOptions::bitstate_bits`),
+ * otherwise `null`, "placement_lookups" and "placement_hit_rate" are those of
+ * `AstarResult::placement_cache` (whose caches carry over between puzzles solved on the same
+ * thread), and "wall_secs" includes reading the file.
+ */
+int solve_batch(
+    const std::vector<std::string>& filenames,
+    int num_threads,
+    const AstarOptions& options,
+    std::ostream& out
+);
+
+#endif
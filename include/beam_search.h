@@ -0,0 +1,36 @@
+#ifndef BEAM_SEARCH_H
+#define BEAM_SEARCH_H
+
+#include "Problem.h"
+#include "astar.h"
+
+/**
+ * Searches for a path from the start position to the target position, like `astar()`, using beam
+ * search on `options.num_threads` threads, which keeps memory and time bounded on boards too large
+ * for best-first search, at the cost of optimality.
+ *
+ * The search proceeds layer by layer, where layer g holds grids with g tetrominoes. Each grid of
+ * the current layer (the beam) is expanded, and only the `options.beam_width` successors with the
+ * lowest h form the next layer, with ties broken by Zobrist hash. Successors are ranked by their
+ * move, hash, and h (see `Grid::successor_h()`) alone, so only the successors kept are ever
+ * constructed. Since every grid in a layer has the same g, duplicates can only occur within a
+ * layer, and are removed by Zobrist hash.
+ *
+ * Each thread expands its share of the beam, keeping its own best `options.beam_width` successors
+ * as it goes, so memory is bounded by the beam width times the number of threads rather than by
+ * the branching factor. The best of those then form the next layer. The search ends at the first
+ * layer in which a successor reaches the target position, or once the beam is empty, in which case
+ * `AstarResult::is_incomplete` is `true` if any successor was discarded.
+ *
+ * Every path cheaper than the solution passes through a discarded successor, so the lowest f of
+ * any discarded successor is a lower bound on the optimal cost, which gives
+ * `AstarResult::suboptimality_bound`. With `Heuristic::FloodFill`, the grids kept are raised to
+ * the flood-fill heuristic (see `Grid::raise_to_flood_fill_heuristic()`), and those from which the
+ * target position is unreachable are pruned.
+ *
+ * `options.visualise` is ignored. Only compiled for the dimensions listed in `GridDimensions.h`.
+ */
+template <int Width, int Height>
+AstarResult beam_search(const Problem<Width, Height>& problem, const AstarOptions& options);
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef BIDIRECTIONAL_SEARCH_H
+#define BIDIRECTIONAL_SEARCH_H
+
+#include "Problem.h"
+#include "astar.h"
+
+/**
+ * Searches for an optimal path from the start position to the target position, like `astar()`,
+ * using bidirectional A* search.
+ *
+ * A forward search grows tetrominoes from the start position, while a backward search grows them
+ * from the target position (beginning with a tetromino on the target position, using the reverse
+ * problem, see `Problem::reversed()`), each expanding from whichever open list is smaller. A
+ * forward grid and a backward grid join into a solution, whose cost is the sum of their actual
+ * costs, if they do not overlap and a piece of one is adjacent to a piece of the other. The
+ * tetrominoes of the backward grid are then placed in an order in which each is adjacent to an
+ * already-placed piece.
+ *
+ * Grids are indexed by the positions of their most recently placed tetromino, so that a generated
+ * grid only looks up grids of the other search on positions adjacent to its own pieces (i.e., its
+ * boundary). If a generated grid and an earlier grid of the other search join, then either the
+ * earlier grid's most recently placed tetromino lies on the generated grid's boundary, or the
+ * earlier grid's parent joins the generated grid too, at a lower cost. So the cheapest join of
+ * any 2 generated grids is always found. The search ends once the cheapest solution found costs
+ * no more than the lowest f of either open list, since every cheaper solution would pass through
+ * an open grid of both searches.
+ *
+ * `options.heuristic` only applies to the forward search. `options.placement_rule` must be
+ * `PlacementRule::Anywhere`, since a backward grid may join a forward grid on any piece of it.
+ * `options.visualise` is ignored. Only compiled for the dimensions listed in `GridDimensions.h`.
+ */
+template <int Width, int Height>
+AstarResult
+bidirectional_search(const Problem<Width, Height>& problem, const AstarOptions& options);
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef DISPLAY_H
+#define DISPLAY_H
+
+#include "FlatBitGrid.h"
+#include "Position.h"
+#include "Problem.h"
+#include "Tetromino.h"
+#include <array>
+#include <ostream>
+#include <span>
+#include <vector>
+
+/**
+ * Displays the board of `problem` to `out`, where a piece has been placed on each position set in
+ * `placements`, highlighting the positions in `previous_move` (e.g., the tetromino most recently
+ * placed).
+ */
+template <int Width, int Height>
+void print_board(
+    std::ostream& out,
+    const Problem<Width, Height>& problem,
+    const FlatBitGrid<Width, Height>& placements,
+    std::span<const Position> previous_move
+);
+
+/**
+ * Clears the most recently displayed board from the console, assuming the most recent output is a
+ * board of height `board_height` followed by a newline.
+ */
+void clear_board_display(int board_height);
+
+/**
+ * Displays the solution `path` (i.e., the tetrominoes placed, in order) to `problem`, allowing for
+ * interactive, move-by-move visualisation through the console.
+ */
+template <int Width, int Height>
+void display_path_interactive(
+    const Problem<Width, Height>& problem,
+    const std::vector<std::array<Position, Tetromino::SIZE>>& path
+);
+
+#endif
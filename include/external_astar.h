@@ -0,0 +1,44 @@
+#ifndef EXTERNAL_ASTAR_H
+#define EXTERNAL_ASTAR_H
+
+#include "Problem.h"
+#include "astar.h"
+
+/**
+ * Searches for an optimal path from the start position to the target position, like `astar()`,
+ * using external-memory A*, which keeps its open and closed lists in spill files under
+ * `options.spill_dir` (or the system's temporary directory, if empty) rather than in memory.
+ *
+ * Grid states are stored as fixed-size records of their placements, Zobrist hash, and most
+ * recently placed tetromino, in 1 bucket per (f, g) pair. Every grid state has a fixed g (the
+ * number of tetrominoes it contains) and h (a function of its placements, and with
+ * `PlacementRule::Chain`, its chain end), so duplicates only occur within a bucket. Successors are
+ * appended to in-memory buffers, which are written to their bucket's file once they hold half of
+ * `options.memory_limit_bytes` in total.
+ *
+ * The next grid state to expand is taken from the open bucket with the lowest f, then the highest
+ * g (or the lowest, with `TieBreaking::ShallowestFirst`). Before it is, duplicate detection is
+ * delayed until the records added to that bucket since it was last closed are sorted by Zobrist
+ * hash (then placements) in runs that fit in the other half of `options.memory_limit_bytes`, and
+ * the runs are merged, dropping duplicates. The result is compared with the bucket's closed list,
+ * which is kept on disk as sorted runs of different grid states, and the grid states that were
+ * not already in it become a new run, and are expanded 1 at a time, so a bucket may be closed
+ * again before they all are. The newest 2 runs are merged while the newer holds at least half as
+ * many records as the older, so a bucket closed n times has O(log n) runs, and each of its records
+ * is rewritten O(log n) times. Once a grid state that reaches the target position is reached, the
+ * path is rebuilt by scanning the closed lists of each layer for the parent of each grid state on
+ * it.
+ *
+ * Memory use is bounded by `options.memory_limit_bytes`, plus a small amount per bucket (such as
+ * the buffer of the file its grid states are expanded from), rather than by the number of grid
+ * states. `AstarResult::is_io_error` is `true` if a spill file could not be written or read. Spill
+ * files are removed once the search ends.
+ *
+ * With `Heuristic::FloodFill`, the estimated cost of each generated grid state is raised before it
+ * is stored, and those from which the target position cannot be reached are pruned.
+ * `options.visualise` is ignored. Only compiled for the dimensions listed in `GridDimensions.h`.
+ */
+template <int Width, int Height>
+AstarResult external_astar(const Problem<Width, Height>& problem, const AstarOptions& options);
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef FRONTIER_SEARCH_H
+#define FRONTIER_SEARCH_H
+
+#include "Problem.h"
+#include "astar.h"
+
+/**
+ * Searches for an optimal path from the start position to the target position, like `astar()`,
+ * using divide-and-conquer frontier A* search.
+ *
+ * Nodes are expanded in the same order as `astar()`, but are removed once expanded, and do not
+ * refer to their parents. Since every move places exactly 1 tetromino, a grid state can only be
+ * generated from grid states with exactly 1 fewer tetromino (i.e., from the layer before its own),
+ * so duplicates are detected by a closed set per layer, which is dropped once no node of the
+ * layer before it remains open. Instead of a parent, each node refers to its ancestor in a
+ * midpoint layer (about halfway to the target position, by the root grid's h), whose grids are
+ * kept as relays. Once the target position is reached, the tetrominoes placed before and after
+ * the relay are found by recursive sub-searches between the start grid, the relay grid, and the
+ * final grid, each of which only places tetrominoes on positions of the grid it must reach.
+ *
+ * Peak memory is therefore bounded by the open nodes and the closed sets still in use, rather
+ * than every node generated. Stats include the nodes of the sub-searches. `options.visualise` is
+ * ignored. Only compiled for the dimensions listed in `GridDimensions.h`.
+ */
+template <int Width, int Height>
+AstarResult frontier_search(const Problem<Width, Height>& problem, const AstarOptions& options);
+
+#endif
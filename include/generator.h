@@ -0,0 +1,46 @@
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include "astar.h"
+#include <cstdint>
+#include <limits>
+#include <optional>
+
+/**
+ * Stores the parameters of `generate_puzzle()`.
+ */
+struct GeneratorParams {
+  // Seed from which every puzzle is derived
+  std::uint64_t seed{0};
+  // Board dimensions, up to `MAX_GRID_WIDTH`x`MAX_GRID_HEIGHT`
+  int width{24};
+  int height{16};
+  // Probability that each position other than the start and target positions is an obstacle, in
+  // [0, 1)
+  double obstacle_density{0.2};
+  // Least Manhattan distance between the start and target positions
+  int min_distance{0};
+  // Range of the heuristic value of the start position (see `Problem::heuristic_value()`), which
+  // estimates the cost of the puzzle (in terms of tetromino moves)
+  int min_estimated_cost{0};
+  int max_estimated_cost{std::numeric_limits<int>::max()};
+};
+
+/**
+ * Returns puzzle `index` of the sequence of puzzles derived from `params.seed`, or no puzzle if
+ * none was found in `MAX_GENERATOR_ATTEMPTS` attempts.
+ *
+ * Each attempt places the start and target positions uniformly at random, at least
+ * `params.min_distance` apart, then makes each other position an obstacle with probability
+ * `params.obstacle_density`. It is kept if the target position can be reached from the start
+ * position, and the start position's heuristic value is within the estimated cost range.
+ *
+ * Random numbers are drawn from `std::mt19937_64` without standard distributions (whose output
+ * differs between standard libraries), so a puzzle depends only on `params` and `index`, on any
+ * platform, and not on which other puzzles are generated.
+ */
+std::optional<AstarParams> generate_puzzle(const GeneratorParams& params, std::uint64_t index);
+
+inline constexpr int MAX_GENERATOR_ATTEMPTS{10000};
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef HDA_STAR_H
+#define HDA_STAR_H
+
+#include "Problem.h"
+#include "astar.h"
+
+/**
+ * Searches for an optimal path from the start position to the target position, like `astar()`,
+ * using hash-distributed A* (HDA*) on `options.num_threads` threads.
+ *
+ * Each thread owns the grid states whose Zobrist hash maps to it, along with their nodes, their
+ * part of the closed set, and an open list of its own, so no search state is shared between
+ * threads. A thread expands its best node, handles successor grids that it owns itself, and sends
+ * the rest to their owners in batches through lock-free queues. Every grid state has a fixed g
+ * (the number of tetrominoes it contains), so duplicate detection by the owner is exact, and
+ * nodes are never reopened.
+ *
+ * Once any thread expands a node that reaches the target position, its cost becomes the
+ * incumbent, and nodes whose f is not lower are discarded. The search ends when every thread is
+ * idle and no batch is in flight, which is detected by a single counter of busy threads plus
+ * batches in flight. Since f is a lower bound, no cheaper path can exist at that point, so the
+ * incumbent is optimal.
+ *
+ * `options.visualise` is ignored. Only compiled for the dimensions listed in `GridDimensions.h`.
+ */
+template <int Width, int Height>
+AstarResult hda_star(const Problem<Width, Height>& problem, const AstarOptions& options);
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef IDA_STAR_H
+#define IDA_STAR_H
+
+#include "Problem.h"
+#include "astar.h"
+
+/**
+ * Searches for an optimal path from the start position to the target position, like `astar()`,
+ * using iterative-deepening A* (IDA*).
+ *
+ * Runs a series of depth-first searches, each of which abandons any path whose f exceeds a
+ * threshold, raising the threshold to the lowest f that exceeded it after each search. Only the
+ * grids on the current path are held in memory, along with the moves to the successors of each,
+ * so memory stays flat however many nodes are expanded. Successors are searched in order of h
+ * (lowest first).
+ *
+ * If `options.transposition_table_size` is not 0, a direct-mapped table of that many entries
+ * (rounded up to a power of 2) remembers, by Zobrist hash, the raised h of grids whose subtree
+ * exceeded the threshold, so that grids reached again (along another path, or in a later
+ * iteration) are cut off sooner. Such cut-offs are counted as revisited nodes.
+ *
+ * `options.visualise` is ignored. Only compiled for the dimensions listed in `GridDimensions.h`.
+ */
+template <int Width, int Height>
+AstarResult ida_star(const Problem<Width, Height>& problem, const AstarOptions& options);
+
+#endif
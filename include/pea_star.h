@@ -0,0 +1,26 @@
+#ifndef PEA_STAR_H
+#define PEA_STAR_H
+
+#include "Problem.h"
+#include "astar.h"
+
+/**
+ * Searches for a path from the start position to the target position, like `astar()`, using
+ * partial-expansion A* (PEA*), which only constructs the successors that are needed next.
+ *
+ * Each node in the open list has a stored f, which is its own f when first added. Expanding a node
+ * lists its moves (see `Grid::moves()`) and ranks them by the f of the successor each results in
+ * (see `Grid::successor_h()`), without constructing any successor. Only the successors whose f
+ * equals the stored f (or, the first time the node is expanded, does not exceed it) are
+ * constructed and added to the open list, and the node is put back with the lowest f of any other
+ * successor as its stored f, if there is one. Since every successor of a node has a fixed f, each
+ * is constructed at most once, and most of those never needed before the solution is found are
+ * never constructed.
+ *
+ * f is weighted by `options.weight`, as in `astar()`. `options.visualise` is ignored. Only compiled
+ * for the dimensions listed in `GridDimensions.h`.
+ */
+template <int Width, int Height>
+AstarResult pea_star(const Problem<Width, Height>& problem, const AstarOptions& options);
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef SMA_STAR_H
+#define SMA_STAR_H
+
+#include "Problem.h"
+#include "astar.h"
+
+/**
+ * Searches for an optimal path from the start position to the target position, like `astar()`,
+ * using simplified memory-bounded A* (SMA*), which keeps the bytes held by its nodes, open list,
+ * and closed set within `options.memory_limit_bytes`.
+ *
+ * Nodes hold their parent, the move that leads to them from it, f, and g, and their grids are
+ * rebuilt by replaying moves from the root grid. Every node in memory is in the closed set. Before
+ * anything is allocated that would exceed the limit, the worst leaf in the open list (highest f,
+ * then lowest g) is forgotten if it is worse than the successor being added: it is erased from the
+ * closed set, and its f is backed up into its parent, which goes back into the open list with the
+ * lowest f of its forgotten children. Otherwise, the successor's f is backed up into its parent
+ * without it being added. When the parent is expanded again, the successors not in memory are
+ * regenerated with at least that f. Nodes whose successors are all in memory elsewhere are
+ * forgotten once expanded. The closed set's initial table holds no more grids than the limit could,
+ * and the first chunks of nodes and closed set entries start small, so any limit that holds the
+ * nodes along a path to the target position lets the search progress.
+ *
+ * If nothing can be forgotten, i.e., the limit cannot hold the nodes along the current paths,
+ * `AstarResult::is_incomplete` is `true`. `AstarResult::peak_memory` holds the bytes accounted for
+ * when the search held the most. While the search runs, `options.on_memory_usage` (if not empty) is
+ * called with the bytes accounted for whenever their total has changed by at least
+ * `options.memory_usage_step_bytes` since the last call.
+ *
+ * With `Heuristic::FloodFill`, the estimated cost of each grid about to be expanded is raised (see
+ * `Grid::raise_to_flood_fill_heuristic()`), and its node put back in the open list if its f rises,
+ * or forgotten if the target position cannot be reached from it. `options.tie_breaking` must be
+ * `TieBreaking::DeepestFirst`, since a node put back in the open list when a child does not fit
+ * must be ordered after its children, or it would be expanded again and again. `options.weight`
+ * and `options.visualise` are ignored. Only compiled for the dimensions listed in
+ * `GridDimensions.h`.
+ */
+template <int Width, int Height>
+AstarResult sma_star(const Problem<Width, Height>& problem, const AstarOptions& options);
+
+#endif
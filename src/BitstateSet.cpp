@@ -0,0 +1,110 @@
+#include "../include/BitstateSet.h"
+#include "../include/FlatBitGrid.h"
+#include "../include/GridDimensions.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+/**
+ * Returns `value` with its bits mixed, so that every bit of the result depends on every bit of
+ * `value` (the finaliser of SplitMix64).
+ */
+std::uint64_t mix(std::uint64_t value) {
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+  return value ^ (value >> 31);
+}
+}
+
+template <int Width, int Height>
+BitstateSet<Width, Height>::BitstateSet(std::size_t num_bits, int num_hashes, bool has_variants)
+    : m_words(std::bit_floor(std::max<std::size_t>(num_bits, WORD_BITS)) / WORD_BITS)
+    , m_mask{m_words.size() * WORD_BITS - 1}
+    , m_num_hashes{std::max(num_hashes, 1)}
+    , m_has_variants{has_variants} {}
+
+template <int Width, int Height>
+bool BitstateSet<Width, Height>::insert(
+    const FlatBitGrid& placements, std::size_t hash, std::uint32_t variant
+) {
+  if (!m_has_variants) {
+    variant = 0;
+  }
+
+  auto bit{first_bit(hash)};
+  auto bit_step{step(placements, variant)};
+  int num_new_bits{0};
+
+  for (int i{0}; i < m_num_hashes; ++i, bit = (bit + bit_step) & m_mask) {
+    auto& word{m_words[bit / WORD_BITS]};
+    auto mask{Word{1} << (bit % WORD_BITS)};
+
+    if ((word & mask) == 0) {
+      word |= mask;
+      ++num_new_bits;
+    }
+  }
+
+  if (num_new_bits == 0) {
+    return false;
+  }
+
+  // Probability that this entry would have been reported as present, before its bits were set
+  auto fill{static_cast<double>(m_num_set_bits) / static_cast<double>(m_mask + 1)};
+  auto false_positive_probability{std::pow(fill, m_num_hashes)};
+  m_expected_lost += false_positive_probability / (1.0 - false_positive_probability);
+
+  m_num_set_bits += num_new_bits;
+  ++m_size;
+
+  return true;
+}
+
+template <int Width, int Height>
+void BitstateSet<Width, Height>::prefetch(std::size_t hash) const {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(&m_words[first_bit(hash) / WORD_BITS]);
+#endif
+}
+
+template <int Width, int Height>
+std::size_t BitstateSet<Width, Height>::size() const {
+  return m_size;
+}
+
+template <int Width, int Height>
+std::size_t BitstateSet<Width, Height>::memory_bytes() const {
+  return m_words.capacity() * sizeof(Word);
+}
+
+template <int Width, int Height>
+double BitstateSet<Width, Height>::false_positive_rate() const {
+  auto num_new{static_cast<double>(m_size) + m_expected_lost};
+  return num_new > 0.0 ? m_expected_lost / num_new : 0.0;
+}
+
+template <int Width, int Height>
+std::size_t BitstateSet<Width, Height>::first_bit(std::size_t hash) const {
+  return mix(hash) & m_mask;
+}
+
+template <int Width, int Height>
+std::size_t BitstateSet<Width, Height>::step(const FlatBitGrid& placements, std::uint32_t variant) {
+  // Multiply-rotate hash of the words, which is independent of the Zobrist hash
+  std::uint64_t hash{variant};
+
+  for (auto word : placements.words()) {
+    hash = std::rotl((hash ^ word) * 0x9e3779b97f4a7c15, 29);
+  }
+
+  // Odd, so that the bits of an entry are distinct when `num_hashes` is at most the number of bits
+  return mix(hash) | 1;
+}
+
+#define INSTANTIATE_BITSTATE_SET(width, height) template class BitstateSet<width, height>;
+FOR_EACH_GRID_DIMENSIONS(INSTANTIATE_BITSTATE_SET)
+#undef INSTANTIATE_BITSTATE_SET
@@ -0,0 +1,303 @@
+#include "../include/ClosedSet.h"
+#include "../include/FlatBitGrid.h"
+#include "../include/GridDimensions.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace {
+/**
+ * Returns the number of slots needed to hold `capacity` entries at a load factor of at most 7/8.
+ */
+std::size_t num_slots_for(std::size_t capacity) {
+  return std::bit_ceil(std::max<std::size_t>(capacity + capacity / 7 + 1, 16));
+}
+}
+
+template <int Width, int Height>
+ClosedSet<Width, Height>::ClosedSet(std::size_t capacity, bool has_variants)
+    : m_has_variants{has_variants} {
+  m_entry_chunks.reserve(capacity / CHUNK_SIZE + 1);
+
+  if (m_has_variants) {
+    m_variant_chunks.reserve(capacity / CHUNK_SIZE + 1);
+  }
+
+  rehash(num_slots_for(capacity));
+}
+
+template <int Width, int Height>
+bool ClosedSet<Width, Height>::insert(
+    const FlatBitGrid& placements, std::size_t hash, std::uint32_t variant
+) {
+  assert(m_num_entries < NO_ENTRY && "Too many entries");
+
+  if (m_size >= capacity()) {
+    rehash((m_mask + 1) * 2);
+  }
+
+  if (!m_has_variants) {
+    variant = 0;
+  }
+
+  auto index{
+      m_erased_entry != NO_ENTRY ? m_erased_entry : static_cast<std::uint32_t>(m_num_entries)
+  };
+
+  if (!place({tag(hash), index}, &placements, variant)) {
+    return false;
+  }
+
+  ++m_size;
+
+  if (index == m_erased_entry) {
+    m_erased_entry = static_cast<std::uint32_t>(*entry(index));
+    std::ranges::copy(placements.words(), entry(index));
+
+    if (m_has_variants) {
+      m_variant_chunks[index >> CHUNK_SHIFT][index & (CHUNK_SIZE - 1)] = variant;
+    }
+
+    return true;
+  }
+
+  if (auto chunk_size{grown_chunk_size()}; chunk_size != 0) {
+    if (m_num_entries % CHUNK_SIZE == 0) {
+      m_entry_chunks.emplace_back();
+
+      if (m_has_variants) {
+        m_variant_chunks.emplace_back();
+      }
+    }
+
+    m_entry_chunks.back().reserve(chunk_size * NUM_WORDS);
+
+    if (m_has_variants) {
+      m_variant_chunks.back().reserve(chunk_size);
+    }
+  }
+
+  const auto& words{placements.words()};
+  m_entry_chunks.back().insert(m_entry_chunks.back().end(), words.begin(), words.end());
+
+  if (m_has_variants) {
+    m_variant_chunks.back().push_back(variant);
+  }
+
+  ++m_num_entries;
+
+  return true;
+}
+
+template <int Width, int Height>
+bool ClosedSet<Width, Height>::erase(
+    const FlatBitGrid& placements, std::size_t hash, std::uint32_t variant
+) {
+  if (!m_has_variants) {
+    variant = 0;
+  }
+
+  auto slot_tag{tag(hash)};
+  const auto& words{placements.words()};
+  auto i{slot_tag & m_mask};
+
+  for (std::size_t distance{0};; i = (i + 1) & m_mask, ++distance) {
+    const auto& curr{m_slots[i]};
+
+    // Since slots stay ordered by ideal slot, `placements` would have been found by now
+    if (curr.tag == EMPTY_TAG || ((i - (curr.tag & m_mask)) & m_mask) < distance) {
+      return false;
+    }
+
+    if (curr.tag == slot_tag && std::equal(words.begin(), words.end(), entry(curr.entry))
+        && variant == this->variant(curr.entry)) {
+      break;
+    }
+  }
+
+  auto index{m_slots[i].entry};
+  *entry(index) = m_erased_entry;
+  m_erased_entry = index;
+  --m_size;
+
+  // Slots after it that are not in their ideal slot shift back by 1, so no probe stops early
+  for (auto next{(i + 1) & m_mask};
+       m_slots[next].tag != EMPTY_TAG && (m_slots[next].tag & m_mask) != next;
+       i = next, next = (next + 1) & m_mask) {
+    m_slots[i] = m_slots[next];
+  }
+
+  m_slots[i] = {};
+
+  return true;
+}
+
+template <int Width, int Height>
+void ClosedSet<Width, Height>::prefetch(std::size_t hash) const {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(&m_slots[tag(hash) & m_mask]);
+#endif
+}
+
+template <int Width, int Height>
+std::size_t ClosedSet<Width, Height>::size() const {
+  return m_size;
+}
+
+template <int Width, int Height>
+std::size_t ClosedSet<Width, Height>::capacity() const {
+  auto num_slots{m_mask + 1};
+  return num_slots - num_slots / 8;
+}
+
+template <int Width, int Height>
+std::size_t ClosedSet<Width, Height>::memory_bytes() const {
+  auto bytes{m_slots.capacity() * sizeof(Slot)};
+  bytes += m_entry_chunks.capacity() * sizeof(std::vector<Word>)
+           + allocated_entries() * NUM_WORDS * sizeof(Word);
+  bytes += m_variant_chunks.capacity() * sizeof(std::vector<std::uint32_t>);
+
+  if (m_has_variants) {
+    bytes += allocated_entries() * sizeof(std::uint32_t);
+  }
+
+  return bytes;
+}
+
+template <int Width, int Height>
+std::size_t ClosedSet<Width, Height>::insertion_bytes() const {
+  std::size_t bytes{0};
+
+  if (m_size >= capacity()) {
+    bytes += (m_mask + 1) * 2 * sizeof(Slot);
+  }
+
+  auto chunk_size{m_erased_entry == NO_ENTRY ? grown_chunk_size() : 0};
+
+  // While the last chunk grows, its old entries are also held until they have been moved
+  if (chunk_size != 0) {
+    bytes += chunk_size * NUM_WORDS * sizeof(Word);
+
+    if (m_has_variants) {
+      bytes += chunk_size * sizeof(std::uint32_t);
+    }
+  }
+
+  if (chunk_size != 0 && m_num_entries % CHUNK_SIZE == 0) {
+    // The list of chunks itself doubles when full
+    if (m_entry_chunks.size() == m_entry_chunks.capacity()) {
+      bytes += std::max<std::size_t>(m_entry_chunks.capacity(), 1) * sizeof(std::vector<Word>);
+    }
+
+    if (m_has_variants && m_variant_chunks.size() == m_variant_chunks.capacity()) {
+      bytes += std::max<std::size_t>(m_variant_chunks.capacity(), 1)
+               * sizeof(std::vector<std::uint32_t>);
+    }
+  }
+
+  return bytes;
+}
+
+template <int Width, int Height>
+std::uint32_t ClosedSet<Width, Height>::tag(std::size_t hash) {
+  auto hash_tag{static_cast<std::uint32_t>(hash)};
+  return hash_tag == EMPTY_TAG ? EMPTY_TAG + 1 : hash_tag;
+}
+
+template <int Width, int Height>
+const typename ClosedSet<Width, Height>::Word*
+ClosedSet<Width, Height>::entry(std::uint32_t index) const {
+  return &m_entry_chunks[index >> CHUNK_SHIFT][(index & (CHUNK_SIZE - 1)) * NUM_WORDS];
+}
+
+template <int Width, int Height>
+typename ClosedSet<Width, Height>::Word* ClosedSet<Width, Height>::entry(std::uint32_t index) {
+  return &m_entry_chunks[index >> CHUNK_SHIFT][(index & (CHUNK_SIZE - 1)) * NUM_WORDS];
+}
+
+template <int Width, int Height>
+std::uint32_t ClosedSet<Width, Height>::variant(std::uint32_t index) const {
+  return m_has_variants ? m_variant_chunks[index >> CHUNK_SHIFT][index & (CHUNK_SIZE - 1)] : 0;
+}
+
+template <int Width, int Height>
+std::size_t ClosedSet<Width, Height>::grown_chunk_size() const {
+  if (m_num_entries % CHUNK_SIZE == 0) {
+    // Only the first chunk grows, since a set that has filled a chunk is likely to fill more
+    return m_entry_chunks.empty() ? MIN_CHUNK_SIZE : CHUNK_SIZE;
+  }
+
+  auto chunk_capacity{m_entry_chunks.back().capacity() / NUM_WORDS};
+  return m_num_entries % CHUNK_SIZE < chunk_capacity ? 0
+                                                      : std::min(chunk_capacity * 2, CHUNK_SIZE);
+}
+
+template <int Width, int Height>
+std::size_t ClosedSet<Width, Height>::allocated_entries() const {
+  // Every chunk but the last is full
+  if (m_entry_chunks.empty()) {
+    return 0;
+  }
+
+  return (m_entry_chunks.size() - 1) * CHUNK_SIZE + m_entry_chunks.back().capacity() / NUM_WORDS;
+}
+
+template <int Width, int Height>
+bool ClosedSet<Width, Height>::place(
+    Slot slot, const FlatBitGrid* placements, std::uint32_t variant
+) {
+  // Distance of `slot` from its ideal slot
+  std::size_t distance{0};
+
+  for (auto i{slot.tag & m_mask};; i = (i + 1) & m_mask, ++distance) {
+    auto& curr{m_slots[i]};
+
+    if (curr.tag == EMPTY_TAG) {
+      curr = slot;
+      return true;
+    }
+
+    if (placements != nullptr && curr.tag == slot.tag) {
+      const auto& words{placements->words()};
+
+      if (std::equal(words.begin(), words.end(), entry(curr.entry))
+          && variant == this->variant(curr.entry)) {
+        return false;
+      }
+    }
+
+    auto curr_distance{(i - (curr.tag & m_mask)) & m_mask};
+
+    /**
+     * Robin Hood: a slot further from its ideal slot than the current slot takes its place, and the
+     * current slot is placed further along instead. Since slots stay ordered by ideal slot, this
+     * also proves that `placements` is not already present.
+     */
+    if (curr_distance < distance) {
+      std::swap(curr, slot);
+      distance = curr_distance;
+      placements = nullptr;
+    }
+  }
+}
+
+template <int Width, int Height>
+void ClosedSet<Width, Height>::rehash(std::size_t num_slots) {
+  auto old_slots{std::exchange(m_slots, std::vector<Slot>(num_slots))};
+  m_mask = num_slots - 1;
+
+  for (auto slot : old_slots) {
+    if (slot.tag != EMPTY_TAG) {
+      place(slot, nullptr);
+    }
+  }
+}
+
+#define INSTANTIATE_CLOSED_SET(width, height) template class ClosedSet<width, height>;
+FOR_EACH_GRID_DIMENSIONS(INSTANTIATE_CLOSED_SET)
+#undef INSTANTIATE_CLOSED_SET
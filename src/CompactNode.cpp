@@ -0,0 +1,25 @@
+#include "../include/CompactNode.h"
+#include "../include/Node.h"
+#include "../include/Tetromino.h"
+#include <cstdint>
+
+static_assert(sizeof(CompactNode) == 12);
+
+CompactNode::CompactNode(NodeId parent, Move move, int f)
+    : m_parent{parent}
+    , m_f{f}
+    , m_anchor_x{static_cast<std::uint8_t>(move.anchor.x)}
+    , m_anchor_y{static_cast<std::uint8_t>(move.anchor.y)}
+    , m_tetromino{static_cast<std::uint8_t>(move.tetromino)} {}
+
+NodeId CompactNode::parent() const {
+  return m_parent;
+}
+
+Move CompactNode::move() const {
+  return {m_tetromino, {m_anchor_x, m_anchor_y}};
+}
+
+int CompactNode::f() const {
+  return m_f;
+}
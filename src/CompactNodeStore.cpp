@@ -0,0 +1,112 @@
+#include "../include/CompactNodeStore.h"
+#include "../include/CompactNode.h"
+#include "../include/Grid.h"
+#include "../include/GridDimensions.h"
+#include "../include/Node.h"
+#include "../include/Position.h"
+#include "../include/Tetromino.h"
+#include "../include/display.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+namespace {
+/**
+ * Returns the positions covered by `move`.
+ */
+std::array<Position, Tetromino::SIZE> positions(Move move) {
+  std::array<Position, Tetromino::SIZE> positions{};
+
+  std::ranges::transform(
+      FIXED_TETROMINOES[move.tetromino].pieces, positions.begin(), [move](Position piece) {
+        return Position{move.anchor.x + piece.x, move.anchor.y + piece.y};
+      }
+  );
+
+  return positions;
+}
+}
+
+template <int Width, int Height>
+CompactNodeStore<Width, Height>::CompactNodeStore(const Grid& root)
+    : m_root{root} {}
+
+template <int Width, int Height>
+NodeId CompactNodeStore<Width, Height>::add(NodeId parent, Move move, int f) {
+  assert(m_size < NO_NODE && "Too many nodes for a 32-bit id");
+
+  if (m_size % CHUNK_SIZE == 0) {
+    // Reserve the whole chunk up front, so that its nodes are never moved
+    m_chunks.emplace_back().reserve(CHUNK_SIZE);
+  }
+
+  m_chunks.back().emplace_back(parent, move, f);
+
+  return static_cast<NodeId>(m_size++);
+}
+
+template <int Width, int Height>
+const CompactNode& CompactNodeStore<Width, Height>::operator[](NodeId id) const {
+  assert(id < m_size);
+
+  return m_chunks[id >> CHUNK_SHIFT][id & (CHUNK_SIZE - 1)];
+}
+
+template <int Width, int Height>
+std::size_t CompactNodeStore<Width, Height>::size() const {
+  return m_size;
+}
+
+template <int Width, int Height>
+Grid<Width, Height> CompactNodeStore<Width, Height>::grid(NodeId id) const {
+  auto grid{m_root};
+
+  for (auto move : moves(id)) {
+    grid = grid.successor(move);
+  }
+
+  return grid;
+}
+
+template <int Width, int Height>
+std::vector<std::array<Position, Tetromino::SIZE>>
+CompactNodeStore<Width, Height>::path(NodeId id) const {
+  std::vector<std::array<Position, Tetromino::SIZE>> path{};
+
+  for (auto move : moves(id)) {
+    path.push_back(positions(move));
+  }
+
+  return path;
+}
+
+template <int Width, int Height>
+void CompactNodeStore<Width, Height>::print(std::ostream& out, NodeId id) const {
+  auto grid{this->grid(id)};
+
+  if ((*this)[id].parent() != NO_NODE) {
+    print_board(out, grid.problem(), grid.placements(), positions((*this)[id].move()));
+  } else {
+    print_board(out, grid.problem(), grid.placements(), {});
+  }
+}
+
+template <int Width, int Height>
+std::vector<Move> CompactNodeStore<Width, Height>::moves(NodeId id) const {
+  std::vector<Move> moves{};
+
+  for (auto curr{id}; (*this)[curr].parent() != NO_NODE; curr = (*this)[curr].parent()) {
+    moves.push_back((*this)[curr].move());
+  }
+
+  std::ranges::reverse(moves);
+  return moves;
+}
+
+#define INSTANTIATE_COMPACT_NODE_STORE(width, height)                                             \
+  template class CompactNodeStore<width, height>;
+FOR_EACH_GRID_DIMENSIONS(INSTANTIATE_COMPACT_NODE_STORE)
+#undef INSTANTIATE_COMPACT_NODE_STORE
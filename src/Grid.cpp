@@ -1,289 +1,464 @@
 #include "../include/Grid.h"
-#include "../include/BitGrid.h"
+#include "../include/FlatBitGrid.h"
+#include "../include/GridDimensions.h"
+#include "../include/PlacementCache.h"
 #include "../include/Position.h"
+#include "../include/Problem.h"
+#include "../include/Tetromino.h"
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
 #include <cstddef>
-#include <queue>
-#include <stack>
-#include <unordered_map>
-#include <unordered_set>
+#include <cstdint>
 #include <utility>
 #include <vector>
 
 namespace {
-bool is_valid_pos(Position pos) {
-  return pos.x >= 0 && pos.x < Grid::MAX_X && pos.y >= 0 && pos.y < Grid::MAX_Y;
-}
-}
-
-void Grid::set_start(Position pos) {
-  assert(is_valid_pos(pos));
-  s_start = pos;
-}
-
-void Grid::set_target(Position pos) {
-  assert(is_valid_pos(pos));
-  s_target = pos;
-}
+/**
+ * Returns, for each fixed tetromino, the anchors at which the tetromino fits within a
+ * `Width`x`Height` grid.
+ */
+template <int Width, int Height>
+constexpr std::array<FlatBitGrid<Width, Height>, NUM_FIXED_TETROMINOES> make_anchor_bounds() {
+  std::array<FlatBitGrid<Width, Height>, NUM_FIXED_TETROMINOES> anchor_bounds{};
+
+  for (int i{0}; i < NUM_FIXED_TETROMINOES; ++i) {
+    anchor_bounds[i] = FlatBitGrid<Width, Height>::rectangle(
+        0, 0, Width - FIXED_TETROMINOES[i].width + 1, Height - FIXED_TETROMINOES[i].height + 1
+    );
+  }
 
-void Grid::set_obstacles(const BitGrid<MAX_X, MAX_Y>& obstacles) {
-  s_obstacles = obstacles;
+  return anchor_bounds;
 }
 
-void Grid::preprocess_heuristic_values() {
-  /**
-   * Use Dijkstra's algorithm to calculate the optimal cost from the target position to every
-   * non-obstacle position.
-   */
-
-  struct Node {
-    Position pos;
-    int cost;
-
-    bool operator<(Node other) const {
-      return cost > other.cost;
+template <int Width, int Height>
+constexpr auto ANCHOR_BOUNDS{make_anchor_bounds<Width, Height>()};
+
+/**
+ * Returns the neighbourhood of position `pos` (see `PlacementCache::placements()`), where
+ * `free_positions` are the positions that are free. Positions outside the grid are not free.
+ */
+template <int Width, int Height>
+std::uint64_t neighbourhood(const FlatBitGrid<Width, Height>& free_positions, Position pos) {
+  constexpr int RADIUS{PlacementCache::RADIUS};
+  constexpr int SPAN{PlacementCache::SPAN};
+
+  // Columns of the square within the grid, since rows are read as runs of bit indices, which wrap
+  // into the neighbouring rows
+  int first_column{std::max(RADIUS - pos.x, 0)};
+  int last_column{std::min(Width - pos.x + RADIUS, SPAN)};
+  auto columns{((std::uint64_t{1} << last_column) - 1) & ~((std::uint64_t{1} << first_column) - 1)};
+  std::uint64_t neighbourhood{0};
+
+  for (int row{0}; row < SPAN; ++row) {
+    int y{pos.y + row - RADIUS};
+
+    if (y < 0 || y >= Height) {
+      continue;
     }
-  };
-
-  std::priority_queue<Node> unvisited{};
-  std::unordered_set<Position, PositionHash> visited_positions{};
-
-  unvisited.emplace(s_target, 0);
-  s_heuristic_values[s_target] = 0;
-
-  while (!unvisited.empty()) {
-    auto curr{unvisited.top()};
-    unvisited.pop();
-
-    // Finalise optimal cost from target position to `curr.pos`
-    visited_positions.insert(curr.pos);
-
-    Position adj_positions[]{
-        {curr.pos.x, curr.pos.y - 1},
-        {curr.pos.x, curr.pos.y + 1},
-        {curr.pos.x - 1, curr.pos.y},
-        {curr.pos.x + 1, curr.pos.y}
-    };
-
-    // Update neighbours' costs
-    for (auto adj_pos : adj_positions) {
-      // Ignore visited, invalid, or obstacle positions
-      if (visited_positions.contains(adj_pos) || !is_valid_pos(adj_pos)
-          || s_obstacles.is_set(adj_pos)) {
-        continue;
-      }
-
-      int adj_cost{curr.cost + 1};
 
-      if (!s_heuristic_values.contains(adj_pos) || adj_cost < s_heuristic_values[adj_pos]) {
-        s_heuristic_values[adj_pos] = adj_cost;
-        unvisited.emplace(adj_pos, adj_cost);
-      }
-    }
+    auto bits{free_positions.bits(y * Width + pos.x - RADIUS, SPAN)};
+    neighbourhood |= (bits & columns & PlacementCache::ROW_MASKS[row]) << (row * SPAN);
   }
 
-  // Measure cost in terms of tetromino moves instead of single cell moves
-  for (auto& [_, heuristic_value] : s_heuristic_values) {
-    heuristic_value = (heuristic_value + (TETROMINO_SIZE - 1)) / TETROMINO_SIZE;
-  }
+  return neighbourhood;
 }
 
-bool Grid::is_target_enclosed() {
-  /**
-   * Assuming `preprocess_heuristic_values()` has been called (which implements Dijkstra's
-   * algorithm), `s_heuristic_values.contains(s_start)` is `true` if and only if a path from the
-   * target position to the start position exists.
-   *
-   * Dependent on `s_heuristic_values` containing only positions reachable from the target position.
-   */
-
-  assert(
-      !s_heuristic_values.empty()
-      && "Ensure Grid::preprocess_heuristic_values() has been called before calling "
-         "Grid::is_target_enclosed()"
-  );
-
-  return !s_heuristic_values.contains(s_start);
+/**
+ * Returns the variant (see `Grid::variant()`) of a grid following `PlacementRule::Chain` whose
+ * most recently placed tetromino is `FIXED_TETROMINOES[tetromino]`, with its anchor at bit index
+ * `anchor_index`.
+ */
+std::uint32_t chain_variant(int tetromino, int anchor_index) {
+  return static_cast<std::uint32_t>(anchor_index * NUM_FIXED_TETROMINOES + tetromino + 1);
 }
 
-Position Grid::start() {
-  return s_start;
+/**
+ * Returns the value that `Grid::hash()` combines with the Zobrist hash of the placements for
+ * variant `variant`, which is 0 for variant 0. Multiplying by an odd constant keeps distinct
+ * variants distinct, and spreads them across all bits.
+ */
+std::size_t variant_hash(std::uint32_t variant) {
+  return variant * std::size_t{0x9e3779b97f4a7c15};
 }
+}
+
+template <int Width, int Height>
+Grid<Width, Height>::Grid(const Problem<Width, Height>& problem, PlacementRule placement_rule)
+    : m_problem{&problem}
+    , m_h{problem.heuristic_value(problem.start())}
+    , m_placement_rule{placement_rule} {
+  assert(!problem.is_target_enclosed());
 
-Position Grid::target() {
-  return s_target;
+  place(problem.start());
 }
 
-const BitGrid<Grid::MAX_X, Grid::MAX_Y>& Grid::obstacles() {
-  return s_obstacles;
+template <int Width, int Height>
+Grid<Width, Height>::Grid(const Problem<Width, Height>& problem, Move move)
+    : m_problem{&problem}
+    , m_g{1}
+    , m_h{Problem<Width, Height>::UNREACHABLE} {
+  place(FIXED_TETROMINOES[move.tetromino], move.anchor);
+
+  assert(m_placements.is_set(problem.start()));
 }
 
-Grid::Grid() {
-  assert(
-      !s_heuristic_values.empty()
-      && "Ensure `Grid::preprocess_heuristic_values()` has been called before initialising "
-         "instances of Grid"
-  );
+template <int Width, int Height>
+Grid<Width, Height>::Grid(
+    const Problem<Width, Height>& problem,
+    const FlatBitGrid<Width, Height>& placements,
+    int g,
+    Move last_move,
+    PlacementRule placement_rule
+)
+    : Grid{problem, placement_rule} {
+  assert(placements.is_set(problem.start()));
+
+  placements.andnot(m_placements).for_each_set([this](Position pos) { place(pos); });
+  m_g = g;
+
+  if (g == 0) {
+    return;
+  }
+
+  m_last_tetromino = static_cast<std::int16_t>(last_move.tetromino);
+  m_last_anchor = static_cast<std::int16_t>(FlatBitGrid<Width, Height>::index(last_move.anchor));
+
+  // As in `successor()`, only the chain end counts towards the estimated cost
+  if (m_placement_rule == PlacementRule::Chain) {
+    m_h = Problem<Width, Height>::UNREACHABLE;
 
-  // Do not call `s_heuristic_values[s_start]` if target is enclosed, otherwise
-  // future calls to `is_target_enclosed()` will break (since it is dependent on
-  // `s_heuristic_values` containing only positions reachable from the target position)
-  if (!is_target_enclosed()) {
-    m_h = s_heuristic_values[s_start];
-    m_placeables.set(s_start);
-    place(s_start);
+    last_tetromino_positions().for_each_set([this](Position pos) {
+      m_h = std::min(m_problem->heuristic_value(pos), m_h);
+    });
   }
 }
 
-Grid& Grid::operator=(Grid other) {
+template <int Width, int Height>
+Grid<Width, Height>& Grid<Width, Height>::operator=(Grid other) {
+  std::swap(m_problem, other.m_problem);
   std::swap(m_placements, other.m_placements);
-  std::swap(m_placeables, other.m_placeables);
+  std::swap(m_hash, other.m_hash);
   std::swap(m_g, other.m_g);
   std::swap(m_h, other.m_h);
+  std::swap(m_last_tetromino, other.m_last_tetromino);
+  std::swap(m_last_anchor, other.m_last_anchor);
+  std::swap(m_placement_rule, other.m_placement_rule);
   return *this;
 }
 
-bool Grid::operator==(const Grid& other) const {
+template <int Width, int Height>
+bool Grid<Width, Height>::operator==(const Grid& other) const {
   return m_placements == other.m_placements;
 }
 
-bool Grid::operator<(const Grid& other) const {
+template <int Width, int Height>
+bool Grid<Width, Height>::operator<(const Grid& other) const {
   // Grids with lower cost are considered greater
   return (m_g + m_h) > (other.m_g + other.m_h);
 }
 
-std::size_t Grid::hash() const {
-  return m_placements.hash();
+template <int Width, int Height>
+std::size_t Grid<Width, Height>::hash() const {
+  return m_hash ^ variant_hash(variant());
 }
 
-std::vector<Grid> Grid::successors() const {
-  std::vector<Grid> successors{};
-  std::unordered_set<BitGrid<MAX_X, MAX_Y>, BitGridHash<MAX_X, MAX_Y>> visited{};
-
-  // For each position (x, y) adjacent to at least 1 position where a piece has been placed...
-  for (int y{0}; y < BitGrid<MAX_X, MAX_Y>::MAX_Y; ++y) {
-    for (int x{0}; x < BitGrid<MAX_X, MAX_Y>::MAX_X; ++x) {
-      if (m_placeables.is_set({x, y})) {
-        // ...add all successor grids that result from placing a tetromino on the calling grid that
-        // overlaps (x, y)
-        successors.insert_range(successors.end(), successors_from({x, y}, visited));
+template <int Width, int Height>
+std::uint32_t Grid<Width, Height>::variant() const {
+  if (m_placement_rule != PlacementRule::Chain || m_last_tetromino < 0) {
+    return 0;
+  }
+
+  return chain_variant(m_last_tetromino, m_last_anchor);
+}
+
+template <int Width, int Height>
+int Grid<Width, Height>::g() const {
+  return m_g;
+}
+
+template <int Width, int Height>
+int Grid<Width, Height>::h() const {
+  return m_h;
+}
+
+template <int Width, int Height>
+template <typename Fn>
+void Grid<Width, Height>::for_each_move(Fn fn) const {
+  auto free_positions{unoccupied()};
+  auto placeable_positions{placeables()};
+
+  // Positions adjacent to a piece placed before the most recent tetromino, and the bit index of
+  // the most recent tetromino's first piece, which together determine the placements skipped (see
+  // `successors()`)
+  FlatBitGrid<Width, Height> parent_placeable_positions{};
+  int last_first_index{-1};
+
+  // Grids of a chain with equal placements but reached in different orders have different
+  // successors, so none are skipped
+  if (m_placement_rule == PlacementRule::Anywhere && m_last_tetromino >= 0) {
+    const auto& last{FIXED_TETROMINOES[m_last_tetromino]};
+    auto parent_placements{m_placements ^ last_tetromino_positions()};
+
+    parent_placeable_positions = parent_placements.dilated();
+    last_first_index = m_last_anchor + FlatBitGrid<Width, Height>::index(last.pieces[0]);
+  }
+
+  // Every valid placement covers a placeable position with pieces on free positions only, so
+  // for each placeable position, look up the placements that fit around it by its neighbourhood,
+  // and collect their anchors per fixed tetromino (which also merges placements covering more
+  // than 1 placeable position)...
+  std::array<FlatBitGrid<Width, Height>, NUM_FIXED_TETROMINOES> anchors{};
+  auto& cache{PlacementCache::local()};
+
+  placeable_positions.for_each_set([&](Position pos) {
+    const auto& placements{cache.placements(neighbourhood(free_positions, pos))};
+
+    for (std::size_t i{0}; i < placements.size(); ++i) {
+      for (auto word{placements[i]}; word != 0; word &= word - 1) {
+        int placement{static_cast<int>(i) * 64 + std::countr_zero(word)};
+        int tetromino{placement / TETROMINO_SIZE};
+        auto piece{FIXED_TETROMINOES[tetromino].pieces[placement % TETROMINO_SIZE]};
+
+        anchors[tetromino].set({pos.x - piece.x, pos.y - piece.y});
       }
     }
+  });
+
+  // ...then visit each anchor, other than those of placements that are only generated before the
+  // most recent tetromino
+  for (int i{0}; i < NUM_FIXED_TETROMINOES; ++i) {
+    const auto& tetromino{FIXED_TETROMINOES[i]};
+    int first_offset{FlatBitGrid<Width, Height>::index(tetromino.pieces[0])};
+
+    anchors[i].for_each_set([&](Position anchor) {
+      if (FlatBitGrid<Width, Height>::index(anchor) + first_offset < last_first_index
+          && std::ranges::any_of(tetromino.pieces, [&](Position piece) {
+               return parent_placeable_positions.is_set({anchor.x + piece.x, anchor.y + piece.y});
+             })) {
+        return;
+      }
+
+      fn(i, anchor);
+    });
   }
+}
+
+template <int Width, int Height>
+std::vector<Grid<Width, Height>> Grid<Width, Height>::successors() const {
+  std::vector<Grid> successors{};
+
+  for_each_move([&](int tetromino, Position anchor) {
+    successors.push_back(successor({tetromino, anchor}));
+  });
 
   return successors;
 }
 
-bool Grid::is_target_reached() const {
+template <int Width, int Height>
+std::vector<Move> Grid<Width, Height>::moves() const {
+  std::vector<Move> moves{};
+
+  for_each_move([&](int tetromino, Position anchor) { moves.push_back({tetromino, anchor}); });
+
+  return moves;
+}
+
+template <int Width, int Height>
+Grid<Width, Height> Grid<Width, Height>::successor(Move move) const {
+  Grid successor{*this};
+  // A chain's remaining tetrominoes extend from its most recently placed tetromino, so only its
+  // pieces count towards the estimated cost (see `successors()`)
+  if (m_placement_rule == PlacementRule::Chain) {
+    successor.m_h = Problem<Width, Height>::UNREACHABLE;
+  }
+
+  successor.place(FIXED_TETROMINOES[move.tetromino], move.anchor);
+  ++successor.m_g;
+  successor.m_last_tetromino = static_cast<std::int16_t>(move.tetromino);
+  successor.m_last_anchor
+      = static_cast<std::int16_t>(FlatBitGrid<Width, Height>::index(move.anchor));
+  return successor;
+}
+
+template <int Width, int Height>
+int Grid<Width, Height>::successor_h(Move move) const {
+  auto h{m_placement_rule == PlacementRule::Chain ? Problem<Width, Height>::UNREACHABLE : m_h};
+
+  // Mirrors `place()`, which lowers the estimated cost to that of the nearest placed piece
+  for (auto piece : FIXED_TETROMINOES[move.tetromino].pieces) {
+    Position pos{move.anchor.x + piece.x, move.anchor.y + piece.y};
+    h = std::min(m_problem->heuristic_value(pos), h);
+  }
+
+  return h;
+}
+
+template <int Width, int Height>
+std::size_t Grid<Width, Height>::successor_hash(Move move) const {
+  auto hash{m_hash};
+
+  // Mirrors `place()`
+  for (auto piece : FIXED_TETROMINOES[move.tetromino].pieces) {
+    hash ^= FlatBitGrid<Width, Height>::zobrist({move.anchor.x + piece.x, move.anchor.y + piece.y});
+  }
+
+  if (m_placement_rule == PlacementRule::Chain) {
+    hash ^= variant_hash(
+        chain_variant(move.tetromino, FlatBitGrid<Width, Height>::index(move.anchor))
+    );
+  }
+
+  return hash;
+}
+
+template <int Width, int Height>
+bool Grid<Width, Height>::is_target_reached() const {
   return m_h == 0;
 }
 
-std::array<Position, Grid::TETROMINO_SIZE> Grid::difference(const Grid& other) const {
-  std::array<Position, TETROMINO_SIZE> difference{};
-  auto difference_it{difference.begin()};
+template <int Width, int Height>
+bool Grid<Width, Height>::is_target_unreachable() const {
+  return m_h == Problem<Width, Height>::UNREACHABLE;
+}
 
-  for (int x{0}; x < MAX_X; ++x) {
-    for (int y{0}; y < MAX_Y; ++y) {
-      if (m_placements.is_set({x, y}) != other.m_placements.is_set({x, y})) {
-        assert(difference_it != difference.end());
+template <int Width, int Height>
+bool Grid<Width, Height>::raise_to_flood_fill_heuristic() {
+  if (is_target_reached()) {
+    return false;
+  }
 
-        *difference_it = {x, y};
-        ++difference_it;
-      }
+  auto target{m_problem->target()};
+  auto unreached{coverables()};
+  auto frontier{placeables() & unreached};
+  int h{Problem<Width, Height>::UNREACHABLE};
+
+  // Each iteration reaches the coverable positions 1 position further from the placed pieces
+  for (int distance{1}; !frontier.is_empty(); ++distance) {
+    if (frontier.is_set(target)) {
+      h = (distance + (TETROMINO_SIZE - 1)) / TETROMINO_SIZE;
+      break;
     }
+
+    unreached = unreached.andnot(frontier);
+    frontier = frontier.dilated() & unreached;
   }
 
+  if (h <= m_h) {
+    return false;
+  }
+
+  /**
+   * A successor grid keeps the lower of this and the static heuristic values of its new pieces.
+   * This remains admissible, since any path from the old pieces that avoids the new ones is at
+   * least as long as it was before they were placed.
+   */
+  m_h = h;
+  return true;
+}
+
+template <int Width, int Height>
+std::array<Position, Grid<Width, Height>::TETROMINO_SIZE>
+Grid<Width, Height>::difference(const Grid& other) const {
+  std::array<Position, TETROMINO_SIZE> difference{};
+  auto difference_it{difference.begin()};
+
+  (m_placements ^ other.m_placements).for_each_set([&difference, &difference_it](Position pos) {
+    assert(difference_it != difference.end());
+
+    *difference_it = pos;
+    ++difference_it;
+  });
+
   return difference;
 }
 
-const BitGrid<Grid::MAX_X, Grid::MAX_Y>& Grid::placements() const {
+template <int Width, int Height>
+const FlatBitGrid<Width, Height>& Grid<Width, Height>::placements() const {
   return m_placements;
 }
 
-void Grid::place(Position pos) {
-  assert(is_valid_pos(pos));
-  assert(m_placeables.is_set(pos));
+template <int Width, int Height>
+const Problem<Width, Height>& Grid<Width, Height>::problem() const {
+  return *m_problem;
+}
+
+template <int Width, int Height>
+void Grid<Width, Height>::place(Position pos) {
+  assert(pos.x >= 0 && pos.x < Width && pos.y >= 0 && pos.y < Height);
   assert(!m_placements.is_set(pos));
-  assert(!s_obstacles.is_set(pos));
+  assert(!m_problem->obstacles().is_set(pos));
 
   m_placements.set(pos);
-  m_placeables.clear(pos);
-  m_h = std::min(s_heuristic_values[pos], m_h);
-
-  Position adj_positions[]{
-      {pos.x, pos.y - 1}, {pos.x, pos.y + 1}, {pos.x - 1, pos.y}, {pos.x + 1, pos.y}
-  };
+  m_hash ^= FlatBitGrid<Width, Height>::zobrist(pos);
+  m_h = std::min(m_problem->heuristic_value(pos), m_h);
+}
 
-  for (auto adj_pos : adj_positions) {
-    if (is_valid_pos(adj_pos) && !m_placements.is_set(adj_pos) && !s_obstacles.is_set(adj_pos)) {
-      m_placeables.set(adj_pos);
-    }
+template <int Width, int Height>
+void Grid<Width, Height>::place(const Tetromino& tetromino, Position anchor) {
+  for (auto piece : tetromino.pieces) {
+    place({anchor.x + piece.x, anchor.y + piece.y});
   }
 }
 
-std::vector<Grid> Grid::successors_from(
-    Position pos, std::unordered_set<BitGrid<MAX_X, MAX_Y>, BitGridHash<MAX_X, MAX_Y>>& visited
-) const {
-  /* Implemented using iterative depth-limited search, where depth is limited to 4. The actions a
-   * node can take involve placing a piece adjacent to an already placed piece (in this search, not
-   * the entire grid). Since initially there are no previously placed pieces, position `pos` is used
-   * as the initial action, thus ensuring `pos` is overlapped. Nodes at depth 4 (i.e., have taken 4
-   * actions) contain the successor grids.
-   */
+template <int Width, int Height>
+FlatBitGrid<Width, Height> Grid<Width, Height>::placeables() const {
+  auto placed{m_placements};
 
-  struct Node {
-    Grid grid{};
-    std::unordered_set<Position, PositionHash> actions{};
-    int depth{0};
-  };
+  if (m_placement_rule == PlacementRule::Chain) {
+    placed = {};
 
-  std::vector<Grid> successors{};
+    if (m_last_tetromino < 0) {
+      placed.set(m_problem->start());
+    } else {
+      placed = last_tetromino_positions();
+    }
+  }
 
-  std::stack<Node> stack{}; // For depth-limited search
-  stack.emplace(*this, std::unordered_set<Position, PositionHash>{pos}, 0);
+  return placed.dilated().andnot(m_placements | m_problem->obstacles());
+}
 
-  while (!stack.empty()) {
-    auto parent{std::move(stack.top())};
-    stack.pop();
+template <int Width, int Height>
+FlatBitGrid<Width, Height> Grid<Width, Height>::last_tetromino_positions() const {
+  FlatBitGrid<Width, Height> positions{};
+  auto anchor{FlatBitGrid<Width, Height>::position(m_last_anchor)};
 
-    if (parent.depth == TETROMINO_SIZE) {
-      ++parent.grid.m_g;
-      successors.push_back(std::move(parent.grid));
-      continue;
-    }
+  for (auto piece : FIXED_TETROMINOES[m_last_tetromino].pieces) {
+    positions.set({anchor.x + piece.x, anchor.y + piece.y});
+  }
 
-    // Generate children then explore them
-    for (auto action : parent.actions) {
-      Node child{parent};
-      child.grid.place(action);
+  return positions;
+}
 
-      if (visited.contains(child.grid.m_placements)) {
-        continue;
-      } else {
-        visited.insert(child.grid.m_placements);
-      }
+template <int Width, int Height>
+FlatBitGrid<Width, Height> Grid<Width, Height>::unoccupied() const {
+  return FlatBitGrid<Width, Height>::filled().andnot(m_placements | m_problem->obstacles());
+}
 
-      child.actions.erase(action);
-      ++child.depth;
-
-      Position candidate_actions[]{
-          {action.x, action.y - 1},
-          {action.x, action.y + 1},
-          {action.x - 1, action.y},
-          {action.x + 1, action.y}
-      };
-
-      for (auto candidate_action : candidate_actions) {
-        if (is_valid_pos(candidate_action) && !child.grid.m_placements.is_set(candidate_action)
-            && !s_obstacles.is_set(candidate_action)) {
-          child.actions.insert(candidate_action);
-        }
-      }
+template <int Width, int Height>
+FlatBitGrid<Width, Height> Grid<Width, Height>::coverables() const {
+  auto free_positions{unoccupied()};
+  FlatBitGrid<Width, Height> coverable_positions{};
+
+  for (int i{0}; i < NUM_FIXED_TETROMINOES; ++i) {
+    const auto& tetromino{FIXED_TETROMINOES[i]};
+    auto anchors{ANCHOR_BOUNDS<Width, Height>[i]};
+
+    // Find all anchors at which the tetromino fits (see `successors()`)...
+    for (auto piece : tetromino.pieces) {
+      anchors &= free_positions >> FlatBitGrid<Width, Height>::index(piece);
+    }
 
-      stack.push(std::move(child));
+    // ...then map each of them back to the positions its pieces cover
+    for (auto piece : tetromino.pieces) {
+      coverable_positions |= anchors << FlatBitGrid<Width, Height>::index(piece);
     }
   }
 
-  return successors;
+  return coverable_positions;
 }
+
+#define INSTANTIATE_GRID(width, height) template class Grid<width, height>;
+FOR_EACH_GRID_DIMENSIONS(INSTANTIATE_GRID)
+#undef INSTANTIATE_GRID
@@ -0,0 +1,83 @@
+#include "../include/NodeStore.h"
+#include "../include/Grid.h"
+#include "../include/GridDimensions.h"
+#include "../include/Node.h"
+#include "../include/Position.h"
+#include "../include/Tetromino.h"
+#include "../include/display.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+template <int Width, int Height>
+NodeId NodeStore<Width, Height>::add(const Grid& grid, NodeId parent) {
+  if (!m_free_ids.empty()) {
+    auto id{m_free_ids.back()};
+    m_free_ids.pop_back();
+    m_chunks[id >> CHUNK_SHIFT][id & (CHUNK_SIZE - 1)] = Node{grid, parent};
+    return id;
+  }
+
+  assert(m_num_slots < NO_NODE && "Too many nodes for a 32-bit id");
+
+  if (m_num_slots % CHUNK_SIZE == 0) {
+    // Reserve the whole chunk up front, so that its nodes are never moved
+    m_chunks.emplace_back().reserve(CHUNK_SIZE);
+  }
+
+  m_chunks.back().emplace_back(grid, parent);
+
+  return static_cast<NodeId>(m_num_slots++);
+}
+
+template <int Width, int Height>
+void NodeStore<Width, Height>::remove(NodeId id) {
+  assert(id < m_num_slots);
+
+  m_free_ids.push_back(id);
+}
+
+template <int Width, int Height>
+const Node<Width, Height>& NodeStore<Width, Height>::operator[](NodeId id) const {
+  assert(id < m_num_slots);
+
+  return m_chunks[id >> CHUNK_SHIFT][id & (CHUNK_SIZE - 1)];
+}
+
+template <int Width, int Height>
+std::size_t NodeStore<Width, Height>::size() const {
+  return m_num_slots - m_free_ids.size();
+}
+
+template <int Width, int Height>
+std::vector<std::array<Position, Tetromino::SIZE>> NodeStore<Width, Height>::path(NodeId id) const {
+  std::vector<std::array<Position, Tetromino::SIZE>> path{};
+
+  for (auto curr{id}; (*this)[curr].parent() != NO_NODE; curr = (*this)[curr].parent()) {
+    const auto& node{(*this)[curr]};
+    path.push_back(node.grid().difference((*this)[node.parent()].grid()));
+  }
+
+  std::ranges::reverse(path);
+  return path;
+}
+
+template <int Width, int Height>
+void NodeStore<Width, Height>::print(std::ostream& out, NodeId id) const {
+  const auto& node{(*this)[id]};
+  const auto& grid{node.grid()};
+
+  if (node.parent() != NO_NODE) {
+    const auto& parent_grid{(*this)[node.parent()].grid()};
+    print_board(out, grid.problem(), grid.placements(), grid.difference(parent_grid));
+  } else {
+    print_board(out, grid.problem(), grid.placements(), {});
+  }
+}
+
+#define INSTANTIATE_NODE_STORE(width, height) template class NodeStore<width, height>;
+FOR_EACH_GRID_DIMENSIONS(INSTANTIATE_NODE_STORE)
+#undef INSTANTIATE_NODE_STORE
@@ -0,0 +1,97 @@
+#include "../include/OpenList.h"
+#include "../include/Node.h"
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+OpenList::OpenList(TieBreaking tie_breaking)
+    : m_tie_breaking{tie_breaking} {}
+
+void OpenList::push(NodeId id, int f, int g) {
+  assert(0 <= g && g <= f);
+
+  bool is_g_tie_breaker{
+      m_tie_breaking == TieBreaking::DeepestFirst || m_tie_breaking == TieBreaking::ShallowestFirst
+  };
+  int sub_bucket_index{is_g_tie_breaker ? g : 0};
+
+  if (f >= static_cast<int>(m_buckets.size())) {
+    m_buckets.resize(f + 1);
+  }
+
+  auto& bucket{m_buckets[f]};
+
+  if (sub_bucket_index >= static_cast<int>(bucket.sub_buckets.size())) {
+    bucket.sub_buckets.resize(sub_bucket_index + 1);
+  }
+
+  bucket.sub_buckets[sub_bucket_index].ids.push_back(id);
+
+  if (bucket.size == 0 || is_preferred(sub_bucket_index, bucket.best_sub_bucket)) {
+    bucket.best_sub_bucket = sub_bucket_index;
+  }
+
+  if (m_size == 0 || f < m_min_f) {
+    m_min_f = f;
+  }
+
+  ++bucket.size;
+  ++m_size;
+}
+
+NodeId OpenList::pop() {
+  assert(!empty());
+
+  auto& bucket{m_buckets[m_min_f]};
+  auto& sub_bucket{bucket.sub_buckets[bucket.best_sub_bucket]};
+  NodeId id{};
+
+  if (m_tie_breaking == TieBreaking::Fifo) {
+    id = sub_bucket.ids[sub_bucket.head++];
+
+    if (sub_bucket.head == sub_bucket.ids.size()) {
+      sub_bucket.ids.clear();
+      sub_bucket.head = 0;
+    }
+  } else {
+    id = sub_bucket.ids.back();
+    sub_bucket.ids.pop_back();
+  }
+
+  --bucket.size;
+  --m_size;
+
+  // Move on to the next preferred sub-bucket that holds any nodes
+  if (bucket.size != 0) {
+    int step{m_tie_breaking == TieBreaking::DeepestFirst ? -1 : 1};
+
+    while (bucket.sub_buckets[bucket.best_sub_bucket].ids.empty()) {
+      bucket.best_sub_bucket += step;
+    }
+  }
+
+  // Move on to the next f whose bucket holds any nodes
+  while (m_size != 0 && m_buckets[m_min_f].size == 0) {
+    ++m_min_f;
+  }
+
+  return id;
+}
+
+bool OpenList::empty() const {
+  return m_size == 0;
+}
+
+std::size_t OpenList::size() const {
+  return m_size;
+}
+
+int OpenList::min_f() const {
+  assert(!empty());
+
+  return m_min_f;
+}
+
+bool OpenList::is_preferred(int a, int b) const {
+  return m_tie_breaking == TieBreaking::DeepestFirst ? a > b : a < b;
+}
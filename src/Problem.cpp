@@ -0,0 +1,162 @@
+#include "../include/Problem.h"
+#include "../include/FlatBitGrid.h"
+#include "../include/GridDimensions.h"
+#include "../include/Position.h"
+#include "../include/Tetromino.h"
+#include <algorithm>
+#include <cassert>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace {
+bool is_valid_pos(Position pos, int width, int height) {
+  return pos.x >= 0 && pos.x < width && pos.y >= 0 && pos.y < height;
+}
+}
+
+template <int Width, int Height>
+Problem<Width, Height>::Problem(
+    Position start,
+    Position target,
+    const std::vector<Position>& obstacles,
+    int board_width,
+    int board_height
+)
+    : m_start{start}
+    , m_target{target}
+    , m_obstacles{obstacles}
+    , m_board_width{board_width}
+    , m_board_height{board_height} {
+  assert(board_width > 0 && board_width <= Width && board_height > 0 && board_height <= Height);
+  assert(is_valid_pos(start, board_width, board_height));
+  assert(is_valid_pos(target, board_width, board_height));
+
+  // Positions outside the board are treated as obstacles
+  m_obstacles |= FlatBitGrid<Width, Height>::filled().andnot(
+      FlatBitGrid<Width, Height>::rectangle(0, 0, board_width, board_height)
+  );
+
+  preprocess_heuristic_values();
+}
+
+template <int Width, int Height>
+Position Problem<Width, Height>::start() const {
+  return m_start;
+}
+
+template <int Width, int Height>
+Position Problem<Width, Height>::target() const {
+  return m_target;
+}
+
+template <int Width, int Height>
+const FlatBitGrid<Width, Height>& Problem<Width, Height>::obstacles() const {
+  return m_obstacles;
+}
+
+template <int Width, int Height>
+int Problem<Width, Height>::board_width() const {
+  return m_board_width;
+}
+
+template <int Width, int Height>
+int Problem<Width, Height>::board_height() const {
+  return m_board_height;
+}
+
+template <int Width, int Height>
+int Problem<Width, Height>::heuristic_value(Position pos) const {
+  return m_heuristic_values[FlatBitGrid<Width, Height>::index(pos)];
+}
+
+template <int Width, int Height>
+bool Problem<Width, Height>::is_target_enclosed() const {
+  return heuristic_value(m_start) == UNREACHABLE;
+}
+
+template <int Width, int Height>
+Problem<Width, Height> Problem<Width, Height>::reversed() const {
+  assert(!m_is_reversed);
+
+  Problem reversed{*this};
+  std::swap(reversed.m_start, reversed.m_target);
+  reversed.m_obstacles.set(m_start);
+  reversed.m_is_reversed = true;
+  reversed.preprocess_heuristic_values();
+
+  return reversed;
+}
+
+template <int Width, int Height>
+void Problem<Width, Height>::preprocess_heuristic_values() {
+  /**
+   * Use Dijkstra's algorithm to calculate the optimal cost from the target position to every
+   * non-obstacle position.
+   */
+
+  struct Node {
+    Position pos;
+    int cost;
+
+    bool operator<(Node other) const {
+      return cost > other.cost;
+    }
+  };
+
+  std::priority_queue<Node> unvisited{};
+  std::vector<bool> is_visited(FlatBitGrid<Width, Height>::NUM_CELLS, false);
+
+  m_heuristic_values.assign(FlatBitGrid<Width, Height>::NUM_CELLS, UNREACHABLE);
+
+  unvisited.emplace(m_target, 0);
+  m_heuristic_values[FlatBitGrid<Width, Height>::index(m_target)] = 0;
+
+  while (!unvisited.empty()) {
+    auto curr{unvisited.top()};
+    unvisited.pop();
+
+    // Finalise optimal cost from target position to `curr.pos`
+    is_visited[FlatBitGrid<Width, Height>::index(curr.pos)] = true;
+
+    Position adj_positions[]{
+        {curr.pos.x, curr.pos.y - 1},
+        {curr.pos.x, curr.pos.y + 1},
+        {curr.pos.x - 1, curr.pos.y},
+        {curr.pos.x + 1, curr.pos.y}
+    };
+
+    // Update neighbours' costs
+    for (auto adj_pos : adj_positions) {
+      // Ignore invalid, obstacle, or visited positions
+      if (!is_valid_pos(adj_pos, Width, Height) || m_obstacles.is_set(adj_pos)
+          || is_visited[FlatBitGrid<Width, Height>::index(adj_pos)]) {
+        continue;
+      }
+
+      int adj_cost{curr.cost + 1};
+      auto& adj_heuristic_value{m_heuristic_values[FlatBitGrid<Width, Height>::index(adj_pos)]};
+
+      if (adj_cost < adj_heuristic_value) {
+        adj_heuristic_value = adj_cost;
+        unvisited.emplace(adj_pos, adj_cost);
+      }
+    }
+  }
+
+  // The target position of a reverse problem is reached from an adjacent position, which is 1
+  // single cell move nearer
+  int target_distance{m_is_reversed ? 1 : 0};
+
+  // Measure cost in terms of tetromino moves instead of single cell moves
+  for (auto& heuristic_value : m_heuristic_values) {
+    if (heuristic_value != UNREACHABLE) {
+      heuristic_value = std::max(heuristic_value - target_distance, 0);
+      heuristic_value = (heuristic_value + (Tetromino::SIZE - 1)) / Tetromino::SIZE;
+    }
+  }
+}
+
+#define INSTANTIATE_PROBLEM(width, height) template class Problem<width, height>;
+FOR_EACH_GRID_DIMENSIONS(INSTANTIATE_PROBLEM)
+#undef INSTANTIATE_PROBLEM
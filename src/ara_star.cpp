@@ -0,0 +1,220 @@
+#include "../include/ara_star.h"
+#include "../include/ClosedSet.h"
+#include "../include/Grid.h"
+#include "../include/GridDimensions.h"
+#include "../include/Node.h"
+#include "../include/NodeStore.h"
+#include "../include/OpenList.h"
+#include "../include/Problem.h"
+#include "../include/astar.h"
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace {
+template <int Width, int Height>
+class AraStar {
+public:
+  AraStar(const Problem<Width, Height>& problem, const AstarOptions& options);
+
+  void run(AstarResult& result);
+
+private:
+  using Grid = ::Grid<Width, Height>;
+
+  const Problem<Width, Height>& m_problem;
+  AstarOptions m_options;
+  std::chrono::steady_clock::time_point m_start_time{std::chrono::steady_clock::now()};
+  Stats m_stats{};
+
+  NodeStore<Width, Height> m_store{};
+  ClosedSet<Width, Height> m_closed_set;
+  OpenList m_open_list;
+
+  // Node of the best solution so far and its cost, or `NO_NODE` and `Problem::UNREACHABLE`
+  NodeId m_best{NO_NODE};
+  int m_best_cost{Problem<Width, Height>::UNREACHABLE};
+
+  /**
+   * Expands grids in order of f weighted by `weight`, until no open grid has a lower weighted f
+   * than the cost of the best solution. Returns `true` if successful, otherwise (i.e., if out of
+   * time) `false`.
+   */
+  bool improve(double weight);
+
+  /**
+   * Re-orders the open list by f weighted by `weight`, discarding grids that cannot lead to a
+   * cheaper solution than the best so far. Returns the lowest unweighted f of any remaining open
+   * grid, or `Problem::UNREACHABLE` if there is none.
+   */
+  int reorder(double weight);
+
+  /**
+   * Adds a node encapsulating `grid`, whose parent is node `parent`, to the open list, with h
+   * weighted by `weight`.
+   */
+  void push(const Grid& grid, NodeId parent, double weight);
+
+  double elapsed_secs() const;
+};
+
+template <int Width, int Height>
+AraStar<Width, Height>::AraStar(const Problem<Width, Height>& problem, const AstarOptions& options)
+    : m_problem{problem}
+    , m_options{options}
+    , m_closed_set{options.closed_set_capacity, options.placement_rule == PlacementRule::Chain}
+    , m_open_list{options.tie_breaking} {}
+
+template <int Width, int Height>
+void AraStar<Width, Height>::run(AstarResult& result) {
+  Grid root{m_problem, m_options.placement_rule};
+  auto weight{std::max(m_options.weight, 1.0)};
+
+  m_closed_set.insert(root.placements(), root.hash(), root.variant());
+  push(root, NO_NODE, weight);
+
+  while (true) {
+    auto is_complete{improve(weight)};
+    auto next_weight{std::max(weight - m_options.weight_step, 1.0)};
+    auto min_f{reorder(next_weight)};
+
+    result.is_out_of_time = !is_complete;
+    result.stats = m_stats;
+    result.elapsed_secs = elapsed_secs();
+
+    if (m_best == NO_NODE) {
+      break;
+    }
+
+    // Every cheaper solution passes through an open grid, whose unweighted f is admissible
+    auto bound{
+        min_f == Problem<Width, Height>::UNREACHABLE
+            ? 1.0
+            : std::max(static_cast<double>(m_best_cost) / min_f, 1.0)
+    };
+
+    if (is_complete) {
+      bound = std::min(bound, weight);
+    }
+
+    if (!result.is_solved || m_best_cost < result.cost || bound < result.suboptimality_bound) {
+      result.is_solved = true;
+      result.cost = m_best_cost;
+      result.path = m_store.path(m_best);
+      result.suboptimality_bound = bound;
+
+      if (m_options.on_solution) {
+        m_options.on_solution(result);
+      }
+    }
+
+    if (!is_complete || bound == 1.0 || next_weight == weight) {
+      break;
+    }
+
+    weight = next_weight;
+  }
+}
+
+template <int Width, int Height>
+bool AraStar<Width, Height>::improve(double weight) {
+  while (!m_open_list.empty() && m_open_list.min_f() < m_best_cost) {
+    if (m_options.time_limit_secs > 0.0 && elapsed_secs() > m_options.time_limit_secs) {
+      return false;
+    }
+
+    auto best_id{m_open_list.pop()};
+
+    // Nodes are never moved by the store, so this remains valid as successors are added
+    const auto& best{m_store[best_id]};
+
+    // As in `astar()`, the flood-fill heuristic is only calculated for nodes about to be expanded
+    if (m_options.heuristic == Heuristic::FloodFill) {
+      auto grid{best.grid()};
+
+      if (grid.raise_to_flood_fill_heuristic()) {
+        if (grid.is_target_unreachable()) {
+          ++m_stats.pruned;
+        } else if (grid.g() + grid.h() < m_best_cost) {
+          push(grid, best.parent(), weight);
+        }
+
+        continue;
+      }
+    }
+
+    for (const auto& successor : best.grid().successors()) {
+      ++m_stats.generated;
+
+      if (!m_closed_set.insert(
+              successor.placements(), successor.hash(), successor.variant()
+          )) {
+        ++m_stats.revisited;
+        continue;
+      }
+
+      // Solutions are recorded once generated, since their cost is known by then
+      if (successor.is_target_reached()) {
+        if (successor.g() < m_best_cost) {
+          m_best = m_store.add(successor, best_id);
+          m_best_cost = successor.g();
+        }
+      } else if (successor.g() + successor.h() < m_best_cost) {
+        push(successor, best_id, weight);
+      }
+    }
+
+    ++m_stats.expanded;
+  }
+
+  return true;
+}
+
+template <int Width, int Height>
+int AraStar<Width, Height>::reorder(double weight) {
+  OpenList reordered{m_options.tie_breaking};
+  int min_f{Problem<Width, Height>::UNREACHABLE};
+
+  while (!m_open_list.empty()) {
+    auto id{m_open_list.pop()};
+    const auto& grid{m_store[id].grid()};
+
+    if (grid.g() + grid.h() < m_best_cost) {
+      min_f = std::min(grid.g() + grid.h(), min_f);
+      reordered.push(id, weighted_f(grid.g(), grid.h(), weight), grid.g());
+    }
+  }
+
+  m_open_list = std::move(reordered);
+  return min_f;
+}
+
+template <int Width, int Height>
+void AraStar<Width, Height>::push(const Grid& grid, NodeId parent, double weight) {
+  m_open_list.push(m_store.add(grid, parent), weighted_f(grid.g(), grid.h(), weight), grid.g());
+}
+
+template <int Width, int Height>
+double AraStar<Width, Height>::elapsed_secs() const {
+  auto now{std::chrono::steady_clock::now()};
+  return std::chrono::duration_cast<std::chrono::duration<double>>(now - m_start_time).count();
+}
+}
+
+template <int Width, int Height>
+AstarResult ara_star(const Problem<Width, Height>& problem, const AstarOptions& options) {
+  AstarResult result{};
+
+  if (!problem.is_target_enclosed()) {
+    AraStar<Width, Height>{problem, options}.run(result);
+  }
+
+  return result;
+}
+
+#define INSTANTIATE_ARA_STAR(width, height)                                                       \
+  template AstarResult ara_star<width, height>(                                                   \
+      const Problem<width, height>& problem, const AstarOptions& options                          \
+  );
+FOR_EACH_GRID_DIMENSIONS(INSTANTIATE_ARA_STAR)
+#undef INSTANTIATE_ARA_STAR
@@ -1,114 +1,76 @@
 #include "../include/astar.h"
+#include "../include/BitstateSet.h"
+#include "../include/ClosedSet.h"
+#include "../include/CompactNodeStore.h"
 #include "../include/Grid.h"
+#include "../include/GridDimensions.h"
 #include "../include/Node.h"
+#include "../include/OpenList.h"
+#include "../include/PlacementCache.h"
 #include "../include/Position.h"
+#include "../include/Problem.h"
+#include "../include/Tetromino.h"
+#include "../include/ara_star.h"
+#include "../include/beam_search.h"
+#include "../include/bidirectional_search.h"
+#include "../include/display.h"
+#include "../include/external_astar.h"
+#include "../include/frontier_search.h"
+#include "../include/hda_star.h"
+#include "../include/ida_star.h"
+#include "../include/pea_star.h"
+#include "../include/sma_star.h"
 #include <chrono>
-#include <cstddef>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
-#include <memory>
-#include <queue>
 #include <string>
-#include <unordered_set>
+#include <utility>
 #include <vector>
 
-namespace {
-// Node stats for A* search
-struct Stats {
-  int expanded{0};
-  int generated{0};
-  int revisited{0};
-
-  friend std::ostream& operator<<(std::ostream& out, const Stats& stats) {
-    out << "In total,\n";
-    out << stats.expanded << " nodes were expanded,\n";
-    out << stats.generated << " nodes were generated, and\n";
-    out << stats.revisited << " nodes were revisited.\n";
-
-    return out;
-  }
-};
-
-auto make_priority_queue() { // For A* search
-  auto node_ptr_cmp
-      = [](const std::shared_ptr<const Node>& a, const std::shared_ptr<const Node>& b) {
-          return *a < *b;
-        };
-
-  return std::priority_queue<
-      std::shared_ptr<const Node>,
-      std::vector<std::shared_ptr<const Node>>,
-      decltype(node_ptr_cmp)>{node_ptr_cmp};
-}
-
-void clear_grid_display() {
-  // Move cursor up Grid::MAX_Y + 1 times (assumes the most recent output is a grid followed by a
-  // newline)
-  std::cout << "\033[" << Grid::MAX_Y + 1 << 'A';
-  // Clear screen beginning from cursor
-  std::cout << "\033[J";
-}
-
-void display_path_interactive(const std::shared_ptr<const Node>& node) {
-  // Number of newlines after the previously printed grid
-  static constexpr int NUM_OF_NEWLINES_AFTER_GRID{5};
-
-  // Represents path to `node`, where `path[i + 1]` is `path[i]`'s parent
-  std::vector<std::shared_ptr<const Node>> path{};
-
-  std::size_t path_index{0};
-  std::string input{};
+bool read_astar_params(const std::string& filename, AstarParams& params) {
+  std::ifstream file(filename);
 
-  for (auto curr{node}; curr; curr = curr->parent()) {
-    path.emplace_back(curr);
+  if (!file) {
+    return false;
   }
 
-  std::cout << *path[path_index] << '\n';
-  std::cout << "Move: " << path.size() - path_index - 1 << '\n';
-  std::cout << "Press 'n' then Enter to see the next move.\n";
-  std::cout << "Press 'b' then Enter to see the previous move.\n";
-  std::cout << "Press Enter to exit.\n";
+  std::vector<std::string> lines{};
 
-  while (std::getline(std::cin, input) && !input.empty()) {
-    if (input == "b") {
-      path_index = (path_index == path.size() - 1) ? 0 : path_index + 1;
-    } else if (input == "n") {
-      path_index = (path_index == 0) ? path.size() - 1 : path_index - 1;
-    } else {
-      return;
+  for (std::string line{}; std::getline(file, line);) {
+    // Tolerate Windows line endings
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
     }
 
-    // Move cursor up Grid::MAX_Y + 1 + NUM_OF_NEWLINES_AFTER_GRID times
-    std::cout << "\033[" << Grid::MAX_Y + 1 + NUM_OF_NEWLINES_AFTER_GRID << 'A';
-    // Clear screen starting from cursor
-    std::cout << "\033[J";
-
-    std::cout << *path[path_index] << '\n';
-    std::cout << "Move: " << path.size() - path_index - 1 << '\n';
-    std::cout << "Press 'n' then Enter to see the next move.\n";
-    std::cout << "Press 'b' then Enter to see the previous move.\n";
-    std::cout << "Press Enter to exit.\n";
+    lines.push_back(std::move(line));
   }
-}
-}
 
-bool read_astar_params(const std::string& filename, AstarParams& params) {
-  std::ifstream file(filename);
+  // Tolerate trailing empty lines
+  while (!lines.empty() && lines.back().empty()) {
+    lines.pop_back();
+  }
 
-  if (!file) {
+  if (lines.empty() || lines.front().empty() || lines.front().size() > MAX_GRID_WIDTH
+      || lines.size() > MAX_GRID_HEIGHT) {
     return false;
   }
 
+  params.width = static_cast<int>(lines.front().size());
+  params.height = static_cast<int>(lines.size());
+
   bool start_found{false};
   bool target_found{false};
-  std::string line{};
 
-  for (int y{0}; y < Grid::MAX_Y; ++y) {
-    std::getline(file, line);
+  for (int y{0}; y < params.height; ++y) {
+    const auto& line{lines[y]};
+
+    if (line.size() != lines.front().size()) {
+      return false;
+    }
 
-    for (int x{0}; x < Grid::MAX_X; ++x) {
-      char ch{line.data()[x]};
+    for (int x{0}; x < params.width; ++x) {
+      char ch{line[x]};
 
       if (ch == 's' || ch == 'S') {
         if (start_found) {
@@ -144,80 +106,300 @@ bool read_astar_params(const std::string& filename, AstarParams& params) {
   return start_found && target_found;
 }
 
-void astar(
-    Position start, Position target, const std::vector<Position>& obstacles, bool visualise
-) {
-  auto start_time = std::chrono::steady_clock::now();
+bool write_astar_params(const std::string& filename, const AstarParams& params) {
+  std::vector<std::string> lines(params.height, std::string(params.width, '.'));
+
+  for (auto pos : params.obstacles) {
+    lines[pos.y][pos.x] = 'o';
+  }
 
-  Grid::set_start(start);
-  Grid::set_target(target);
-  Grid::set_obstacles(obstacles);
-  Grid::preprocess_heuristic_values();
+  lines[params.start.y][params.start.x] = 's';
+  lines[params.target.y][params.target.x] = 't';
 
-  auto root{std::make_shared<const Node>()};
+  std::ofstream file(filename);
 
-  if (Grid::is_target_enclosed()) {
-    std::cout << "The target is enclosed - no solution exists.\n";
-    return;
+  for (const auto& line : lines) {
+    file << line << '\n';
   }
 
-  std::unordered_set<Grid, GridHash> visited{};
-  Stats stats{};
+  return static_cast<bool>(file);
+}
 
-  auto priority_queue{make_priority_queue()};
-  priority_queue.push(std::move(root));
+namespace {
+/**
+ * Runs the A* search of `astar()` on `problem`, using `visited` as its closed set (a `ClosedSet`
+ * or `BitstateSet`), and stores its outcome in `result`.
+ */
+template <int Width, int Height, typename Visited>
+void search(
+    const Problem<Width, Height>& problem, const AstarOptions& options, Visited& visited,
+    AstarResult& result
+) {
+  using Grid = Grid<Width, Height>;
 
-  std::cout << "Searching for an optimal solution...\n\n";
+  Grid root{problem, options.placement_rule};
+  CompactNodeStore<Width, Height> store{root};
+  auto& stats{result.stats};
 
-  if (visualise) {
-    std::cout << *priority_queue.top() << '\n';
-  }
+  OpenList open_list{options.tie_breaking};
+  auto root_f{weighted_f(root.g(), root.h(), options.weight)};
+  open_list.push(store.add(NO_NODE, {}, root_f), root_f, root.g());
 
-  while (!priority_queue.empty()) {
-    auto best{priority_queue.top()};
-    priority_queue.pop();
+  if (options.visualise) {
+    store.print(std::cout, 0);
+    std::cout << '\n';
+  }
 
-    if (visualise) {
-      clear_grid_display();
-      std::cout << *best << '\n';
-    }
+  // Most recently expanded node and its grid, which the grids of its successors are rebuilt from
+  // in 1 move rather than from the root grid
+  NodeId last_id{NO_NODE};
+  auto last_grid{root};
+
+  while (!open_list.empty()) {
+    auto best_id{open_list.pop()};
+
+    // Nodes are never moved by the store, so this remains valid as successors are added
+    const auto& best{store[best_id]};
+
+    auto grid{
+        last_id != NO_NODE && best.parent() == last_id ? last_grid.successor(best.move())
+                                                        : store.grid(best_id)
+    };
+
+    /**
+     * Most generated nodes are never expanded, so the flood-fill heuristic is only calculated for
+     * nodes about to be expanded. A node whose estimated cost rises above the one it was ordered by
+     * is put back in the open list instead, unless the target position can no longer be reached
+     * from it.
+     */
+    if (options.heuristic == Heuristic::FloodFill && grid.raise_to_flood_fill_heuristic()) {
+      if (grid.is_target_unreachable()) {
+        ++stats.pruned;
+        continue;
+      }
 
-    if (best->grid().is_target_reached()) {
-      auto finish_time{std::chrono::steady_clock::now()};
-      auto elapsed_secs{
-          std::chrono::duration_cast<std::chrono::duration<double>>(finish_time - start_time)
-              .count()
-      };
+      auto raised_f{weighted_f(grid.g(), grid.h(), options.weight)};
 
-      if (visualise) {
-        clear_grid_display();
+      if (raised_f > best.f()) {
+        open_list.push(store.add(best.parent(), best.move(), raised_f), raised_f, grid.g());
+        continue;
       }
+    }
 
-      // Clear "Searching for an optimal solution...\n\n" from console
-      std::cout << "\033[" << 2 << 'A';
-      std::cout << "\033[J";
+    if (options.visualise) {
+      clear_board_display(problem.board_height());
+      store.print(std::cout, best_id);
+      std::cout << '\n';
+    }
 
-      std::cout << "Found an optimal solution in " << std::fixed << std::setprecision(2)
-                << elapsed_secs << " seconds!\n\n";
-      std::cout << stats << '\n';
-      display_path_interactive(best);
+    if (grid.is_target_reached()) {
+      result.is_solved = true;
+      result.path = store.path(best_id);
+      result.cost = static_cast<int>(result.path.size());
+      result.suboptimality_bound = options.weight;
+      break;
+    }
 
-      return;
+    auto moves{grid.moves()};
+
+    // Start fetching every successor's slot in the closed set before probing any of them
+    for (auto move : moves) {
+      visited.prefetch(grid.successor_hash(move));
     }
 
-    for (const auto& successor : best->successors()) {
+    // Successors are only held as grids while being checked against the closed set
+    for (auto move : moves) {
       ++stats.generated;
+      auto successor{grid.successor(move)};
 
-      if (!visited.contains(successor->grid())) {
-        visited.insert(successor->grid());
-        priority_queue.push(std::move(successor));
+      if (visited.insert(successor.placements(), successor.hash(), successor.variant())) {
+        auto f{weighted_f(successor.g(), successor.h(), options.weight)};
+        open_list.push(store.add(best_id, move, f), f, successor.g());
       } else {
         ++stats.revisited;
       }
     }
 
     ++stats.expanded;
+    last_id = best_id;
+    last_grid = std::move(grid);
   }
 
-  std::cout << "An optimal solution could not be found.\n";
+  if (options.visualise) {
+    clear_board_display(problem.board_height());
+  }
 }
+
+/**
+ * Runs `astar()` on `problem` with `options.algorithm`, without recording the lookups of the
+ * calling thread's placement cache.
+ */
+template <int Width, int Height>
+AstarResult run_algorithm(const Problem<Width, Height>& problem, const AstarOptions& options) {
+  if (options.algorithm == Algorithm::HdaStar) {
+    return hda_star(problem, options);
+  }
+
+  if (options.algorithm == Algorithm::IdaStar) {
+    return ida_star(problem, options);
+  }
+
+  if (options.algorithm == Algorithm::FrontierSearch) {
+    return frontier_search(problem, options);
+  }
+
+  if (options.algorithm == Algorithm::Bidirectional) {
+    return bidirectional_search(problem, options);
+  }
+
+  if (options.algorithm == Algorithm::AraStar) {
+    return ara_star(problem, options);
+  }
+
+  if (options.algorithm == Algorithm::BeamSearch) {
+    return beam_search(problem, options);
+  }
+
+  if (options.algorithm == Algorithm::PeaStar) {
+    return pea_star(problem, options);
+  }
+
+  if (options.algorithm == Algorithm::ExternalAstar) {
+    return external_astar(problem, options);
+  }
+
+  if (options.algorithm == Algorithm::SmaStar) {
+    return sma_star(problem, options);
+  }
+
+  auto start_time = std::chrono::steady_clock::now();
+  AstarResult result{};
+
+  if (problem.is_target_enclosed()) {
+    return result;
+  }
+
+  auto has_variants{options.placement_rule == PlacementRule::Chain};
+
+  if (options.bitstate_bits > 0) {
+    BitstateSet<Width, Height> visited{
+        options.bitstate_bits, options.bitstate_hashes, has_variants
+    };
+    search(problem, options, visited, result);
+
+    result.false_positive_rate = visited.false_positive_rate();
+    result.is_incomplete = !result.is_solved;
+  } else {
+    ClosedSet<Width, Height> visited{options.closed_set_capacity, has_variants};
+    search(problem, options, visited, result);
+  }
+
+  auto finish_time{std::chrono::steady_clock::now()};
+  result.elapsed_secs
+      = std::chrono::duration_cast<std::chrono::duration<double>>(finish_time - start_time).count();
+
+  return result;
+}
+}
+
+template <int Width, int Height>
+AstarResult astar(const Problem<Width, Height>& problem, const AstarOptions& options) {
+  // Algorithms that generate successors on other threads add those threads' lookups themselves
+  auto cache_stats_before{PlacementCache::local().stats()};
+  auto result{run_algorithm(problem, options)};
+  result.placement_cache += PlacementCache::local().stats() - cache_stats_before;
+
+  return result;
+}
+
+AstarResult astar(const AstarParams& params, const AstarOptions& options) {
+  return with_problem(params, [&options](const auto& problem) {
+    return astar(problem, options);
+  });
+}
+
+void astar_interactive(const AstarParams& params, const AstarOptions& options) {
+  with_problem(params, [&options](const auto& problem) {
+    if (problem.is_target_enclosed()) {
+      std::cout << "The target is enclosed - no solution exists.\n";
+      return;
+    }
+
+    std::cout << "Searching for an optimal solution...\n\n";
+
+    // Report each solution found along the way, such as by `Algorithm::AraStar`
+    auto search_options{options};
+    int num_lines_reported{0};
+
+    search_options.on_solution = [&num_lines_reported](const AstarResult& solution) {
+      std::cout << "Found a solution of cost " << solution.cost << " (at most " << std::fixed
+                << std::setprecision(2) << solution.suboptimality_bound
+                << " times the optimal cost) in " << solution.elapsed_secs << " seconds\n";
+      ++num_lines_reported;
+    };
+
+    auto result{astar(problem, search_options)};
+
+    // Clear "Searching for an optimal solution...\n\n" and reported solutions from console
+    std::cout << "\033[" << 2 + num_lines_reported << 'A';
+    std::cout << "\033[J";
+
+    if (!result.is_solved) {
+      if (result.is_io_error) {
+        std::cout << "The search failed to write or read its files.\n";
+      } else if (result.is_out_of_time) {
+        std::cout << "A solution could not be found in time.\n";
+      } else if (result.is_incomplete) {
+        std::cout << "A solution could not be found, but one may exist.\n";
+      } else {
+        std::cout << "An optimal solution could not be found.\n";
+      }
+
+      return;
+    }
+
+    // Nodes may have been lost to false positives of a lossy closed set
+    auto is_lossy{options.algorithm == Algorithm::Astar && options.bitstate_bits > 0};
+
+    if (is_lossy) {
+      std::cout << "Found a solution, which may not be optimal, in " << std::fixed
+                << std::setprecision(2) << result.elapsed_secs << " seconds!\n\n";
+    } else if (result.suboptimality_bound > 1.0) {
+      std::cout << "Found a solution of at most " << std::fixed << std::setprecision(2)
+                << result.suboptimality_bound << " times the optimal cost in "
+                << result.elapsed_secs << " seconds!\n\n";
+    } else {
+      std::cout << "Found an optimal solution in " << std::fixed << std::setprecision(2)
+                << result.elapsed_secs << " seconds!\n\n";
+    }
+
+    std::cout << result.stats << '\n';
+
+    if (const auto& memory{result.peak_memory}; memory.total_bytes() > 0) {
+      std::cout << "At most " << memory.total_bytes() << " bytes were held: " << memory.node_bytes
+                << " by nodes, " << memory.open_list_bytes << " by the open list, and "
+                << memory.closed_set_bytes << " by the closed set.\n\n";
+    }
+
+    if (is_lossy) {
+      std::cout << "An estimated " << std::fixed << std::setprecision(4)
+                << 100.0 * result.false_positive_rate
+                << "% of new nodes were lost to false positives of the closed set.\n\n";
+    }
+
+    if (const auto& cache{result.placement_cache}; cache.lookups > 0) {
+      std::cout << cache.lookups << " neighbourhoods were looked up to place tetrominoes, of which "
+                << std::fixed << std::setprecision(2) << 100.0 * cache.hit_rate()
+                << "% were cached.\n\n";
+    }
+
+    display_path_interactive(problem, result.path);
+  });
+}
+
+#define INSTANTIATE_ASTAR(width, height)                                                          \
+  template AstarResult astar<width, height>(                                                       \
+      const Problem<width, height>& problem, const AstarOptions& options                          \
+  );
+FOR_EACH_GRID_DIMENSIONS(INSTANTIATE_ASTAR)
+#undef INSTANTIATE_ASTAR
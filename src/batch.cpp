@@ -0,0 +1,207 @@
+#include "../include/batch.h"
+#include "../include/PlacementCache.h"
+#include "../include/astar.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+std::string to_json_string(const std::string& str) {
+  std::ostringstream out{};
+  out << '"';
+
+  for (char ch : str) {
+    if (ch == '"' || ch == '\\') {
+      out << '\\' << ch;
+    } else if (static_cast<unsigned char>(ch) < 0x20) {
+      out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(ch)
+          << std::dec;
+    } else {
+      out << ch;
+    }
+  }
+
+  out << '"';
+  return out.str();
+}
+
+namespace {
+struct PuzzleOutcome {
+  bool is_solved{false};
+  // JSON result line (see `solve_batch()`)
+  std::string line{};
+};
+
+/**
+ * Solves puzzle file `filename` with `options`, then returns its outcome.
+ */
+PuzzleOutcome solve_puzzle(const std::string& filename, const AstarOptions& options) {
+  auto start_time{std::chrono::steady_clock::now()};
+
+  AstarParams params{};
+  std::optional<AstarResult> result{};
+
+  auto search_options{options};
+  search_options.visualise = false;
+
+  if (read_astar_params(filename, params)) {
+    result = astar(params, search_options);
+  }
+
+  auto finish_time{std::chrono::steady_clock::now()};
+  auto wall_secs{
+      std::chrono::duration_cast<std::chrono::duration<double>>(finish_time - start_time).count()
+  };
+
+  std::ostringstream line{};
+  line << "{\"file\":" << to_json_string(filename) << ",\"status\":";
+
+  if (!result) {
+    line << "\"invalid\"";
+  } else if (!result->is_solved && result->is_io_error) {
+    line << "\"io_error\"";
+  } else if (!result->is_solved && result->is_out_of_time) {
+    line << "\"out_of_time\"";
+  } else if (!result->is_solved && result->is_incomplete) {
+    line << "\"not_found\"";
+  } else if (!result->is_solved) {
+    line << "\"unsolvable\"";
+  } else {
+    line << "\"solved\"";
+  }
+
+  if (result && result->is_solved) {
+    line << ",\"cost\":" << result->cost << ",\"bound\":" << result->suboptimality_bound;
+  } else {
+    line << ",\"cost\":null,\"bound\":null";
+  }
+
+  auto stats{result ? result->stats : Stats{}};
+  line << ",\"expanded\":" << stats.expanded << ",\"generated\":" << stats.generated
+       << ",\"revisited\":" << stats.revisited << ",\"pruned\":" << stats.pruned;
+
+  if (result && result->peak_memory.total_bytes() > 0) {
+    line << ",\"peak_bytes\":" << result->peak_memory.total_bytes();
+  } else {
+    line << ",\"peak_bytes\":null";
+  }
+
+  if (result && options.algorithm == Algorithm::Astar && options.bitstate_bits > 0) {
+    line << ",\"false_positive_rate\":" << result->false_positive_rate;
+  } else {
+    line << ",\"false_positive_rate\":null";
+  }
+
+  auto placement_cache{result ? result->placement_cache : PlacementCache::Stats{}};
+  line << ",\"placement_lookups\":" << placement_cache.lookups
+       << ",\"placement_hit_rate\":" << placement_cache.hit_rate();
+
+  line << ",\"wall_secs\":" << std::fixed << std::setprecision(6) << wall_secs << "}\n";
+
+  return {result && result->is_solved, line.str()};
+}
+}
+
+std::vector<std::string> collect_puzzle_files(const std::vector<std::string>& paths) {
+  std::vector<std::string> filenames{};
+
+  for (const auto& path : paths) {
+    std::error_code error{};
+
+    if (!std::filesystem::is_directory(path, error)) {
+      filenames.push_back(path);
+      continue;
+    }
+
+    std::vector<std::string> directory_filenames{};
+
+    for (const auto& entry : std::filesystem::directory_iterator{path, error}) {
+      if (entry.is_regular_file(error) && entry.path().extension() == ".txt") {
+        directory_filenames.push_back(entry.path().string());
+      }
+    }
+
+    std::ranges::sort(directory_filenames);
+    filenames.insert(filenames.end(), directory_filenames.begin(), directory_filenames.end());
+  }
+
+  return filenames;
+}
+
+bool read_manifest(const std::string& filename, std::vector<std::string>& paths) {
+  std::ifstream file(filename);
+
+  if (!file) {
+    return false;
+  }
+
+  auto manifest_directory{std::filesystem::path{filename}.parent_path()};
+
+  for (std::string line{}; std::getline(file, line);) {
+    // Tolerate Windows line endings
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+
+    if (line.empty() || line.front() == '#') {
+      continue;
+    }
+
+    std::filesystem::path path{line};
+    paths.push_back(path.is_absolute() ? path.string() : (manifest_directory / path).string());
+  }
+
+  return true;
+}
+
+int solve_batch(
+    const std::vector<std::string>& filenames,
+    int num_threads,
+    const AstarOptions& options,
+    std::ostream& out
+) {
+  // Result lines, stored until all puzzles before them are done so that output is in order
+  std::vector<std::optional<std::string>> lines(filenames.size());
+  std::size_t next_line_to_write{0};
+  int num_solved{0};
+  std::mutex lines_mutex{};
+
+  // Index of the next puzzle to be claimed by a worker
+  std::atomic<std::size_t> next_puzzle{0};
+
+  auto worker{[&] {
+    for (auto i{next_puzzle.fetch_add(1)}; i < filenames.size(); i = next_puzzle.fetch_add(1)) {
+      auto outcome{solve_puzzle(filenames[i], options)};
+
+      std::scoped_lock lock{lines_mutex};
+
+      num_solved += outcome.is_solved;
+      lines[i] = std::move(outcome.line);
+
+      while (next_line_to_write < lines.size() && lines[next_line_to_write]) {
+        out << *lines[next_line_to_write] << std::flush;
+        lines[next_line_to_write].reset();
+        ++next_line_to_write;
+      }
+    }
+  }};
+
+  {
+    std::vector<std::jthread> workers{};
+
+    for (int i{0}; i < std::max(num_threads, 1); ++i) {
+      workers.emplace_back(worker);
+    }
+  }
+
+  return num_solved;
+}
@@ -0,0 +1,405 @@
+#include "../include/beam_search.h"
+#include "../include/Grid.h"
+#include "../include/GridDimensions.h"
+#include "../include/PlacementCache.h"
+#include "../include/Position.h"
+#include "../include/Problem.h"
+#include "../include/Tetromino.h"
+#include "../include/astar.h"
+#include <algorithm>
+#include <array>
+#include <barrier>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace {
+/**
+ * A successor of a grid in the beam, which is only constructed if it is kept.
+ */
+struct Candidate {
+  std::size_t hash;
+  int h;
+  // Index of the grid it is a successor of, in the beam
+  int parent;
+  Move move;
+};
+
+/**
+ * Returns `true` if `lhs` is preferred over `rhs` for the next layer, which is a strict total
+ * order over candidates with distinct hashes.
+ */
+bool is_better(const Candidate& lhs, const Candidate& rhs) {
+  return std::tie(lhs.h, lhs.hash) < std::tie(rhs.h, rhs.hash);
+}
+
+/**
+ * State of a beam search (see `beam_search()`).
+ */
+template <int Width, int Height>
+class BeamSearch {
+public:
+  BeamSearch(const Problem<Width, Height>& problem, const AstarOptions& options);
+
+  void run(AstarResult& result);
+
+private:
+  using Grid = ::Grid<Width, Height>;
+
+  /**
+   * Refers to the grid of the previous layer that a grid of a layer is a successor of, and the
+   * move between them.
+   */
+  struct Step {
+    int parent;
+    Move move;
+  };
+
+  const Problem<Width, Height>& m_problem;
+  AstarOptions m_options;
+  int m_num_threads;
+
+  // Grids of the current layer, all with the same g
+  std::vector<Grid> m_beam{};
+  // Steps to the grids of each layer after the first, indexed by g - 1 then by index in the beam
+  std::vector<std::vector<Step>> m_steps{};
+
+  // Best candidates for the next layer generated by each thread
+  std::vector<std::vector<Candidate>> m_selected{};
+  // Best successor of the beam that reaches the target position found by each thread, if any
+  std::vector<std::optional<Candidate>> m_goals{};
+  // Lowest f of any discarded candidate found by each thread
+  std::vector<int> m_discarded_min_f{};
+  std::vector<Stats> m_stats{};
+  // Lookups of the placement cache of each thread other than the calling thread, whose own are
+  // recorded by `astar()`
+  std::vector<PlacementCache::Stats> m_placement_cache{};
+
+  // Threads other than the calling thread, started once per search, which wait at `m_barrier`
+  // with the calling thread before and after each call of `m_task`
+  std::vector<std::jthread> m_workers{};
+  std::barrier<> m_barrier;
+  std::function<void(int)> m_task{};
+  // Set before the workers are released for the last time, so that they return instead
+  bool m_is_done{false};
+
+  /**
+   * Starts the `m_num_threads - 1` workers.
+   */
+  void start_workers();
+
+  /**
+   * Releases the workers to return, and waits until they have.
+   */
+  void stop_workers();
+
+  /**
+   * Calls `task(thread)` on each of `m_num_threads` threads, and returns once all have returned.
+   */
+  void run_in_parallel(std::function<void(int)> task);
+
+  /**
+   * Expands thread `thread`'s share of the beam, keeping its best `options.beam_width` successors
+   * as candidates for the next layer.
+   */
+  void generate(int thread);
+
+  /**
+   * Removes duplicates from `candidates`, counting them in `stats`, then keeps the best
+   * `options.beam_width`, in order, and lowers `discarded_min_f` to the lowest f of any other,
+   * where each has actual cost `g`.
+   */
+  void select(std::vector<Candidate>& candidates, int g, Stats& stats, int& discarded_min_f) const;
+
+  /**
+   * Returns the tetrominoes placed along the path to the grid that `goal`, a successor of the
+   * beam, results in, in order.
+   */
+  std::vector<std::array<Position, Tetromino::SIZE>> reconstruct_path(const Candidate& goal) const;
+};
+
+template <int Width, int Height>
+BeamSearch<Width, Height>::BeamSearch(
+    const Problem<Width, Height>& problem, const AstarOptions& options
+)
+    : m_problem{problem}
+    , m_options{options}
+    , m_num_threads{std::max(options.num_threads, 1)}
+    , m_selected(m_num_threads)
+    , m_goals(m_num_threads)
+    , m_discarded_min_f(m_num_threads, Problem<Width, Height>::UNREACHABLE)
+    , m_stats(m_num_threads)
+    , m_placement_cache(m_num_threads)
+    , m_barrier{m_num_threads} {}
+
+template <int Width, int Height>
+void BeamSearch<Width, Height>::run(AstarResult& result) {
+  Grid root{m_problem, m_options.placement_rule};
+
+  if (m_options.heuristic == Heuristic::FloodFill) {
+    root.raise_to_flood_fill_heuristic();
+  }
+
+  if (root.is_target_unreachable()) {
+    ++m_stats.front().pruned;
+  } else {
+    m_beam.push_back(root);
+  }
+
+  std::optional<Candidate> goal{};
+  start_workers();
+
+  while (!m_beam.empty() && !goal) {
+    run_in_parallel([this](int thread) { generate(thread); });
+
+    for (const auto& thread_goal : m_goals) {
+      if (thread_goal && (!goal || thread_goal->hash < goal->hash)) {
+        goal = thread_goal;
+      }
+    }
+
+    if (goal) {
+      break;
+    }
+
+    // Each thread keeps at most `options.beam_width` candidates, so this is cheap next to
+    // generating them
+    std::vector<Candidate> next{};
+
+    for (const auto& selected : m_selected) {
+      next.insert(next.end(), selected.begin(), selected.end());
+    }
+
+    select(next, m_beam.front().g() + 1, m_stats.front(), m_discarded_min_f.front());
+
+    // Only the successors kept are constructed
+    std::vector<std::optional<Grid>> next_beam(next.size());
+
+    run_in_parallel([&](int thread) {
+      for (auto i{static_cast<std::size_t>(thread)}; i < next.size(); i += m_num_threads) {
+        auto grid{m_beam[next[i].parent].successor(next[i].move)};
+
+        if (m_options.heuristic == Heuristic::FloodFill) {
+          grid.raise_to_flood_fill_heuristic();
+
+          if (grid.is_target_unreachable()) {
+            ++m_stats[thread].pruned;
+            continue;
+          }
+        }
+
+        next_beam[i] = grid;
+      }
+    });
+
+    m_beam.clear();
+    auto& steps{m_steps.emplace_back()};
+
+    for (std::size_t i{0}; i < next.size(); ++i) {
+      if (next_beam[i]) {
+        m_beam.push_back(*next_beam[i]);
+        steps.push_back({next[i].parent, next[i].move});
+      }
+    }
+  }
+
+  stop_workers();
+
+  for (const auto& stats : m_stats) {
+    result.stats.expanded += stats.expanded;
+    result.stats.generated += stats.generated;
+    result.stats.revisited += stats.revisited;
+    result.stats.pruned += stats.pruned;
+  }
+
+  for (const auto& placement_cache : m_placement_cache) {
+    result.placement_cache += placement_cache;
+  }
+
+  auto discarded_min_f{std::ranges::min(m_discarded_min_f)};
+
+  if (!goal) {
+    result.is_incomplete = discarded_min_f != Problem<Width, Height>::UNREACHABLE;
+    return;
+  }
+
+  result.is_solved = true;
+  result.path = reconstruct_path(*goal);
+  result.cost = static_cast<int>(result.path.size());
+  result.suboptimality_bound
+      = static_cast<double>(result.cost) / std::min(discarded_min_f, result.cost);
+}
+
+template <int Width, int Height>
+void BeamSearch<Width, Height>::start_workers() {
+  for (int i{1}; i < m_num_threads; ++i) {
+    m_workers.emplace_back([this, i] {
+      auto cache_stats_before{PlacementCache::local().stats()};
+
+      while (true) {
+        m_barrier.arrive_and_wait();
+
+        if (m_is_done) {
+          break;
+        }
+
+        m_task(i);
+        m_barrier.arrive_and_wait();
+      }
+
+      m_placement_cache[i] += PlacementCache::local().stats() - cache_stats_before;
+    });
+  }
+}
+
+template <int Width, int Height>
+void BeamSearch<Width, Height>::stop_workers() {
+  m_is_done = true;
+  m_barrier.arrive_and_wait();
+  m_workers.clear();
+}
+
+template <int Width, int Height>
+void BeamSearch<Width, Height>::run_in_parallel(std::function<void(int)> task) {
+  // The barrier orders writing the task before the workers read it, and their results before the
+  // calling thread reads them
+  m_task = std::move(task);
+  m_barrier.arrive_and_wait();
+  m_task(0);
+  m_barrier.arrive_and_wait();
+}
+
+template <int Width, int Height>
+void BeamSearch<Width, Height>::generate(int thread) {
+  auto g{m_beam.front().g() + 1};
+  auto& stats{m_stats[thread]};
+  auto& selected{m_selected[thread]};
+  auto& goal{m_goals[thread]};
+  auto& discarded_min_f{m_discarded_min_f[thread]};
+
+  // Worst candidate kept by the last call to `select()`, if it kept a full beam, since no worse
+  // candidate can be among the best `options.beam_width`
+  std::optional<Candidate> worst{};
+  selected.clear();
+
+  for (auto i{static_cast<std::size_t>(thread)}; i < m_beam.size(); i += m_num_threads) {
+    const auto& grid{m_beam[i]};
+
+    for (auto move : grid.moves()) {
+      ++stats.generated;
+      Candidate candidate{
+          grid.successor_hash(move), grid.successor_h(move), static_cast<int>(i), move
+      };
+
+      if (candidate.h == 0) {
+        if (!goal || candidate.hash < goal->hash) {
+          goal = candidate;
+        }
+
+        continue;
+      }
+
+      if (worst && !is_better(candidate, *worst)) {
+        discarded_min_f = std::min(g + candidate.h, discarded_min_f);
+        continue;
+      }
+
+      selected.push_back(candidate);
+
+      if (selected.size() >= 2 * m_options.beam_width) {
+        select(selected, g, stats, discarded_min_f);
+
+        if (selected.size() == m_options.beam_width) {
+          worst = selected.back();
+        }
+      }
+    }
+
+    ++stats.expanded;
+  }
+
+  select(selected, g, stats, discarded_min_f);
+}
+
+template <int Width, int Height>
+void BeamSearch<Width, Height>::select(
+    std::vector<Candidate>& candidates, int g, Stats& stats, int& discarded_min_f
+) const {
+  // Of each set of duplicates, the one with the lowest h, then from the earliest grid in the beam,
+  // is kept
+  std::ranges::sort(candidates, [](const Candidate& lhs, const Candidate& rhs) {
+    return std::tie(lhs.hash, lhs.h, lhs.parent) < std::tie(rhs.hash, rhs.h, rhs.parent);
+  });
+
+  auto duplicates{std::ranges::unique(candidates, {}, &Candidate::hash)};
+  stats.revisited += static_cast<int>(duplicates.size());
+  candidates.erase(duplicates.begin(), duplicates.end());
+
+  auto width{std::min(m_options.beam_width, candidates.size())};
+  auto kept_end{candidates.begin() + static_cast<std::ptrdiff_t>(width)};
+
+  std::ranges::nth_element(candidates, kept_end, is_better);
+
+  for (auto it{kept_end}; it != candidates.end(); ++it) {
+    discarded_min_f = std::min(g + it->h, discarded_min_f);
+  }
+
+  candidates.erase(kept_end, candidates.end());
+  std::ranges::sort(candidates, is_better);
+}
+
+template <int Width, int Height>
+std::vector<std::array<Position, Tetromino::SIZE>>
+BeamSearch<Width, Height>::reconstruct_path(const Candidate& goal) const {
+  std::vector<std::array<Position, Tetromino::SIZE>> path{};
+
+  auto push_move{[&path](Move move) {
+    auto& positions{path.emplace_back()};
+
+    std::ranges::transform(
+        FIXED_TETROMINOES[move.tetromino].pieces, positions.begin(), [move](Position piece) {
+          return Position{move.anchor.x + piece.x, move.anchor.y + piece.y};
+        }
+    );
+  }};
+
+  push_move(goal.move);
+
+  for (auto layer{m_steps.size()}, index{static_cast<std::size_t>(goal.parent)}; layer > 0;
+       --layer) {
+    const auto& step{m_steps[layer - 1][index]};
+    push_move(step.move);
+    index = static_cast<std::size_t>(step.parent);
+  }
+
+  std::ranges::reverse(path);
+  return path;
+}
+}
+
+template <int Width, int Height>
+AstarResult beam_search(const Problem<Width, Height>& problem, const AstarOptions& options) {
+  auto start_time{std::chrono::steady_clock::now()};
+  AstarResult result{};
+
+  if (!problem.is_target_enclosed()) {
+    BeamSearch<Width, Height>{problem, options}.run(result);
+  }
+
+  auto finish_time{std::chrono::steady_clock::now()};
+  result.elapsed_secs
+      = std::chrono::duration_cast<std::chrono::duration<double>>(finish_time - start_time).count();
+
+  return result;
+}
+
+#define INSTANTIATE_BEAM_SEARCH(width, height)                                                    \
+  template AstarResult beam_search<width, height>(                                                \
+      const Problem<width, height>& problem, const AstarOptions& options                          \
+  );
+FOR_EACH_GRID_DIMENSIONS(INSTANTIATE_BEAM_SEARCH)
+#undef INSTANTIATE_BEAM_SEARCH
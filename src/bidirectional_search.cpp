@@ -0,0 +1,307 @@
+#include "../include/bidirectional_search.h"
+#include "../include/ClosedSet.h"
+#include "../include/FlatBitGrid.h"
+#include "../include/Grid.h"
+#include "../include/GridDimensions.h"
+#include "../include/Node.h"
+#include "../include/NodeStore.h"
+#include "../include/OpenList.h"
+#include "../include/Position.h"
+#include "../include/Problem.h"
+#include "../include/Tetromino.h"
+#include "../include/astar.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace {
+template <int Width, int Height>
+class BidirectionalSearch {
+public:
+  BidirectionalSearch(const Problem<Width, Height>& problem, const AstarOptions& options);
+
+  void run(AstarResult& result);
+
+private:
+  using Grid = ::Grid<Width, Height>;
+  using FlatBitGrid = ::FlatBitGrid<Width, Height>;
+  using Path = std::vector<std::array<Position, Tetromino::SIZE>>;
+
+  /**
+   * Refers to a node by id, along with the actual cost of its grid, so that nodes that cannot join
+   * a cheaper solution are skipped without reading them.
+   */
+  struct IndexEntry {
+    NodeId id;
+    int g;
+  };
+
+  /**
+   * State of the search in 1 direction.
+   */
+  struct Frontier {
+    explicit Frontier(const AstarOptions& options)
+        : closed_set{options.closed_set_capacity / 2}
+        , open_list{options.tie_breaking}
+        , nodes_by_position(FlatBitGrid::NUM_CELLS) {}
+
+    NodeStore<Width, Height> store{};
+    ClosedSet<Width, Height> closed_set;
+    OpenList open_list;
+    // Nodes whose most recently placed tetromino (or the start position, for the root node of the
+    // forward search) covers each position, indexed by `FlatBitGrid::index()`
+    std::vector<std::vector<IndexEntry>> nodes_by_position;
+  };
+
+  const Problem<Width, Height>& m_problem;
+  Problem<Width, Height> m_reverse_problem;
+  AstarOptions m_options;
+  Stats m_stats{};
+
+  Frontier m_forward;
+  Frontier m_backward;
+
+  // Cost of the cheapest solution found so far, or `Problem::UNREACHABLE`, and the forward and
+  // backward nodes it joins (where the backward node is `NO_NODE` if the forward node has reached
+  // the target position by itself)
+  int m_best_cost{Problem<Width, Height>::UNREACHABLE};
+  NodeId m_best_forward{NO_NODE};
+  NodeId m_best_backward{NO_NODE};
+
+  /**
+   * Adds a node encapsulating `grid`, whose parent is node `parent` (or `NO_NODE` for a root
+   * node), to `frontier` if its grid state has not been generated by it before and it may lead to
+   * a cheaper solution, then records any cheaper solution that it joins.
+   */
+  void add(Frontier& frontier, const Grid& grid, NodeId parent);
+
+  /**
+   * Removes the best node from `frontier`'s open list, then expands it.
+   */
+  void expand(Frontier& frontier);
+
+  /**
+   * Returns the tetrominoes placed along the solution joining forward node `forward` and backward
+   * node `backward` (which may be `NO_NODE`), in order.
+   */
+  Path reconstruct_path(NodeId forward, NodeId backward) const;
+};
+
+template <int Width, int Height>
+BidirectionalSearch<Width, Height>::BidirectionalSearch(
+    const Problem<Width, Height>& problem, const AstarOptions& options
+)
+    : m_problem{problem}
+    , m_reverse_problem{problem.reversed()}
+    , m_options{options}
+    , m_forward{options}
+    , m_backward{options} {}
+
+template <int Width, int Height>
+void BidirectionalSearch<Width, Height>::run(AstarResult& result) {
+  add(m_forward, Grid{m_problem}, NO_NODE);
+
+  // The backward search begins with every tetromino that covers the target position
+  auto target{m_reverse_problem.start()};
+
+  for (int i{0}; i < NUM_FIXED_TETROMINOES; ++i) {
+    const auto& tetromino{FIXED_TETROMINOES[i]};
+
+    for (auto piece : tetromino.pieces) {
+      Position anchor{target.x - piece.x, target.y - piece.y};
+
+      if (anchor.x < 0 || anchor.y < 0 || anchor.x + tetromino.width > Width
+          || anchor.y + tetromino.height > Height) {
+        continue;
+      }
+
+      if (std::ranges::none_of(tetromino.pieces, [&](Position other_piece) {
+            Position pos{anchor.x + other_piece.x, anchor.y + other_piece.y};
+            return m_reverse_problem.obstacles().is_set(pos);
+          })) {
+        ++m_stats.generated;
+        add(m_backward, Grid{m_reverse_problem, {i, anchor}}, NO_NODE);
+      }
+    }
+  }
+
+  while (true) {
+    auto forward_min_f{
+        m_forward.open_list.empty() ? Problem<Width, Height>::UNREACHABLE
+                                    : m_forward.open_list.min_f()
+    };
+    auto backward_min_f{
+        m_backward.open_list.empty() ? Problem<Width, Height>::UNREACHABLE
+                                     : m_backward.open_list.min_f()
+    };
+
+    if (m_best_cost <= std::max(forward_min_f, backward_min_f)) {
+      break;
+    }
+
+    expand(
+        m_forward.open_list.size() <= m_backward.open_list.size() ? m_forward : m_backward
+    );
+  }
+
+  if (m_best_cost != Problem<Width, Height>::UNREACHABLE) {
+    result.is_solved = true;
+    result.cost = m_best_cost;
+    result.path = reconstruct_path(m_best_forward, m_best_backward);
+  }
+
+  result.stats = m_stats;
+}
+
+template <int Width, int Height>
+void BidirectionalSearch<Width, Height>::add(Frontier& frontier, const Grid& grid, NodeId parent) {
+  if (grid.g() + grid.h() >= m_best_cost) {
+    return;
+  }
+
+  if (!frontier.closed_set.insert(grid.placements(), grid.hash())) {
+    ++m_stats.revisited;
+    return;
+  }
+
+  auto id{frontier.store.add(grid, parent)};
+  frontier.open_list.push(id, grid.g() + grid.h(), grid.g());
+
+  auto is_forward{&frontier == &m_forward};
+  const auto& placements{grid.placements()};
+
+  auto newest{
+      parent == NO_NODE ? placements : placements ^ frontier.store[parent].grid().placements()
+  };
+
+  newest.for_each_set([&](Position pos) {
+    frontier.nodes_by_position[FlatBitGrid::index(pos)].push_back({id, grid.g()});
+  });
+
+  if (is_forward && grid.is_target_reached() && grid.g() < m_best_cost) {
+    m_best_cost = grid.g();
+    m_best_forward = id;
+    m_best_backward = NO_NODE;
+  }
+
+  // Look up nodes of the other search that this node joins, on its boundary
+  const auto& other{is_forward ? m_backward : m_forward};
+
+  placements.dilated().andnot(placements).for_each_set([&](Position pos) {
+    for (auto entry : other.nodes_by_position[FlatBitGrid::index(pos)]) {
+      if (grid.g() + entry.g < m_best_cost
+          && !placements.intersects(other.store[entry.id].grid().placements())) {
+        m_best_cost = grid.g() + entry.g;
+        m_best_forward = is_forward ? id : entry.id;
+        m_best_backward = is_forward ? entry.id : id;
+      }
+    }
+  });
+}
+
+template <int Width, int Height>
+void BidirectionalSearch<Width, Height>::expand(Frontier& frontier) {
+  auto id{frontier.open_list.pop()};
+
+  // Nodes are never moved by the store, so this remains valid as successors are added
+  const auto& node{frontier.store[id]};
+
+  // As in `astar()`, the flood-fill heuristic is only calculated for nodes about to be expanded
+  if (&frontier == &m_forward && m_options.heuristic == Heuristic::FloodFill) {
+    auto grid{node.grid()};
+
+    if (grid.raise_to_flood_fill_heuristic()) {
+      if (grid.is_target_unreachable()) {
+        ++m_stats.pruned;
+      } else {
+        // The node stays indexed under its original id, which has the same grid state and parent
+        auto raised_id{frontier.store.add(grid, node.parent())};
+        frontier.open_list.push(raised_id, grid.g() + grid.h(), grid.g());
+      }
+
+      return;
+    }
+  }
+
+  for (const auto& successor : node.grid().successors()) {
+    ++m_stats.generated;
+    add(frontier, successor, id);
+  }
+
+  ++m_stats.expanded;
+}
+
+template <int Width, int Height>
+typename BidirectionalSearch<Width, Height>::Path
+BidirectionalSearch<Width, Height>::reconstruct_path(NodeId forward, NodeId backward) const {
+  auto path{m_forward.store.path(forward)};
+
+  if (backward == NO_NODE) {
+    return path;
+  }
+
+  // Tetrominoes of the backward node, which have only been placed in an order in which each is
+  // adjacent to the target position's tetromino
+  std::vector<FlatBitGrid> tetrominoes{};
+
+  for (auto curr{backward}; curr != NO_NODE; curr = m_backward.store[curr].parent()) {
+    const auto& node{m_backward.store[curr]};
+    auto placements{node.grid().placements()};
+
+    if (node.parent() != NO_NODE) {
+      placements ^= m_backward.store[node.parent()].grid().placements();
+    }
+
+    tetrominoes.push_back(placements);
+  }
+
+  // Place them in an order in which each is adjacent to an already-placed piece instead, which
+  // exists since the forward node's and backward node's pieces are connected
+  auto placed{m_forward.store[forward].grid().placements()};
+
+  while (!tetrominoes.empty()) {
+    auto it{std::ranges::find_if(tetrominoes, [&placed](const FlatBitGrid& tetromino) {
+      return tetromino.intersects(placed.dilated());
+    })};
+
+    std::array<Position, Tetromino::SIZE> positions{};
+    auto positions_it{positions.begin()};
+    it->for_each_set([&positions_it](Position pos) { *positions_it++ = pos; });
+
+    path.push_back(positions);
+    placed |= *it;
+    tetrominoes.erase(it);
+  }
+
+  return path;
+}
+}
+
+template <int Width, int Height>
+AstarResult
+bidirectional_search(const Problem<Width, Height>& problem, const AstarOptions& options) {
+  assert(options.placement_rule == PlacementRule::Anywhere);
+
+  auto start_time{std::chrono::steady_clock::now()};
+  AstarResult result{};
+
+  if (!problem.is_target_enclosed()) {
+    BidirectionalSearch<Width, Height>{problem, options}.run(result);
+  }
+
+  auto finish_time{std::chrono::steady_clock::now()};
+  result.elapsed_secs
+      = std::chrono::duration_cast<std::chrono::duration<double>>(finish_time - start_time).count();
+
+  return result;
+}
+
+#define INSTANTIATE_BIDIRECTIONAL_SEARCH(width, height)                                           \
+  template AstarResult bidirectional_search<width, height>(                                       \
+      const Problem<width, height>& problem, const AstarOptions& options                          \
+  );
+FOR_EACH_GRID_DIMENSIONS(INSTANTIATE_BIDIRECTIONAL_SEARCH)
+#undef INSTANTIATE_BIDIRECTIONAL_SEARCH
@@ -0,0 +1,131 @@
+#include "../include/display.h"
+#include "../include/FlatBitGrid.h"
+#include "../include/GridDimensions.h"
+#include "../include/Position.h"
+#include "../include/Problem.h"
+#include "../include/Tetromino.h"
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <span>
+#include <string>
+#include <vector>
+
+template <int Width, int Height>
+void print_board(
+    std::ostream& out,
+    const Problem<Width, Height>& problem,
+    const FlatBitGrid<Width, Height>& placements,
+    std::span<const Position> previous_move
+) {
+  // Unicode character symbols
+  static constexpr char HOLLOW_SQUARE[]{"\u25A1"};
+  static constexpr char SOLID_SQUARE[]{"\u25A0"};
+  static constexpr char STAR[]{"\u2605"};
+  static constexpr char CENTRE_DOT[]{"\u00B7"};
+
+  // ANSI colour codes
+  static constexpr char RED[]{"\033[31m"};
+  static constexpr char YELLOW[]{"\033[33m"};
+  static constexpr char RESET_COLOUR[]{"\033[0m"};
+
+  for (int y{0}; y < problem.board_height(); ++y) {
+    for (int x{0}; x < problem.board_width(); ++x) {
+      Position pos{x, y};
+
+      if (std::ranges::contains(previous_move, pos)) {
+        out << RED << SOLID_SQUARE << RESET_COLOUR;
+      } else if (pos == problem.start() || placements.is_set(pos)) {
+        out << RED << HOLLOW_SQUARE << RESET_COLOUR;
+      } else if (pos == problem.target()) {
+        out << YELLOW << STAR << RESET_COLOUR;
+      } else if (problem.obstacles().is_set(pos)) {
+        out << SOLID_SQUARE;
+      } else {
+        out << CENTRE_DOT;
+      }
+
+      out << ' ';
+    }
+
+    out << '\n';
+  }
+}
+
+void clear_board_display(int board_height) {
+  // Move cursor up `board_height` + 1 times
+  std::cout << "\033[" << board_height + 1 << 'A';
+  // Clear screen beginning from cursor
+  std::cout << "\033[J";
+}
+
+template <int Width, int Height>
+void display_path_interactive(
+    const Problem<Width, Height>& problem,
+    const std::vector<std::array<Position, Tetromino::SIZE>>& path
+) {
+  // Number of newlines after the previously printed board
+  static constexpr int NUM_OF_NEWLINES_AFTER_BOARD{5};
+
+  int num_moves{static_cast<int>(path.size())};
+  // Number of moves made in the displayed board (the final board is displayed first)
+  int move{num_moves};
+  std::string input{};
+
+  auto print_move{[&problem, &path, &move, num_moves] {
+    FlatBitGrid<Width, Height> placements{};
+    placements.set(problem.start());
+
+    for (int i{0}; i < move; ++i) {
+      for (auto pos : path[i]) {
+        placements.set(pos);
+      }
+    }
+
+    print_board(
+        std::cout,
+        problem,
+        placements,
+        (move == 0) ? std::span<const Position>{} : std::span<const Position>{path[move - 1]}
+    );
+
+    std::cout << '\n';
+    std::cout << "Move: " << move << '\n';
+    std::cout << "Press 'n' then Enter to see the next move.\n";
+    std::cout << "Press 'b' then Enter to see the previous move.\n";
+    std::cout << "Press Enter to exit.\n";
+  }};
+
+  print_move();
+
+  while (std::getline(std::cin, input) && !input.empty()) {
+    if (input == "b") {
+      move = (move == 0) ? num_moves : move - 1;
+    } else if (input == "n") {
+      move = (move == num_moves) ? 0 : move + 1;
+    } else {
+      return;
+    }
+
+    // Move cursor up board height + 1 + NUM_OF_NEWLINES_AFTER_BOARD times
+    std::cout << "\033[" << problem.board_height() + 1 + NUM_OF_NEWLINES_AFTER_BOARD << 'A';
+    // Clear screen starting from cursor
+    std::cout << "\033[J";
+
+    print_move();
+  }
+}
+
+#define INSTANTIATE_DISPLAY(width, height)                                                        \
+  template void print_board(                                                                      \
+      std::ostream& out,                                                                          \
+      const Problem<width, height>& problem,                                                      \
+      const FlatBitGrid<width, height>& placements,                                               \
+      std::span<const Position> previous_move                                                     \
+  );                                                                                              \
+  template void display_path_interactive(                                                         \
+      const Problem<width, height>& problem,                                                      \
+      const std::vector<std::array<Position, Tetromino::SIZE>>& path                              \
+  );
+FOR_EACH_GRID_DIMENSIONS(INSTANTIATE_DISPLAY)
+#undef INSTANTIATE_DISPLAY
@@ -0,0 +1,976 @@
+#include "../include/external_astar.h"
+#include "../include/FlatBitGrid.h"
+#include "../include/Grid.h"
+#include "../include/GridDimensions.h"
+#include "../include/OpenList.h"
+#include "../include/Position.h"
+#include "../include/Problem.h"
+#include "../include/Tetromino.h"
+#include "../include/astar.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <ios>
+#include <map>
+#include <optional>
+#include <queue>
+#include <random>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+// Size of the buffer used to read a spill file sequentially, other than while merging sorted runs
+// or expanding a bucket
+constexpr std::size_t READ_BUFFER_BYTES{std::size_t{1} << 20};
+
+// Number of records read sequentially in about the time of a seek, above which a closed run is
+// binary searched for the few records added to its bucket, rather than read in full
+constexpr std::size_t RECORDS_PER_SEEK{64};
+
+// Size of the buffer used to read each bucket's grid states to expand, small since a search may
+// leave many buckets partly expanded at once
+constexpr std::size_t EXPAND_BUFFER_BYTES{std::size_t{1} << 16};
+
+/**
+ * A grid state as stored in a spill file, from which its grid is restored (see `Grid::Grid()`).
+ */
+template <int Width, int Height>
+struct Record {
+  // See `Grid::hash()` and `Grid::variant()`
+  std::size_t hash;
+  std::uint32_t variant;
+  // Index and anchor bit index of the most recently placed tetromino, or -1 and 0 for the initial
+  // grid
+  std::int16_t tetromino;
+  std::int16_t anchor;
+  FlatBitGrid<Width, Height> placements;
+
+  Move move() const {
+    return {tetromino, FlatBitGrid<Width, Height>::position(anchor)};
+  }
+};
+
+/**
+ * Returns `true` if `lhs` is sorted before `rhs` in a bucket's closed list, where duplicates are
+ * adjacent.
+ */
+template <int Width, int Height>
+bool is_before(const Record<Width, Height>& lhs, const Record<Width, Height>& rhs) {
+  if (std::tie(lhs.hash, lhs.variant) != std::tie(rhs.hash, rhs.variant)) {
+    return std::tie(lhs.hash, lhs.variant) < std::tie(rhs.hash, rhs.variant);
+  }
+
+  return std::ranges::lexicographical_compare(lhs.placements.words(), rhs.placements.words());
+}
+
+/**
+ * Returns `true` if `lhs` and `rhs` are the same grid state, though they may have been reached by
+ * different moves.
+ */
+template <int Width, int Height>
+bool is_duplicate(const Record<Width, Height>& lhs, const Record<Width, Height>& rhs) {
+  return lhs.hash == rhs.hash && lhs.variant == rhs.variant && lhs.placements == rhs.placements;
+}
+
+/**
+ * Returns `true` if the spill file `file`, which holds `num_records` sorted records, has a
+ * duplicate of `record`, found by binary search, reading 1 record per step.
+ */
+template <int Width, int Height>
+bool has_duplicate(
+    std::ifstream& file, std::size_t num_records, const Record<Width, Height>& record
+) {
+  std::size_t first{0};
+
+  // Finds the first record not sorted before `record`, which is its duplicate if any
+  for (auto count{num_records}; count > 0;) {
+    auto half{count / 2};
+    Record<Width, Height> middle{};
+    file.seekg(static_cast<std::streamoff>((first + half) * sizeof(middle)));
+    file.read(reinterpret_cast<char*>(&middle), sizeof(middle));
+
+    if (!file) {
+      return false;
+    }
+
+    if (is_before(middle, record)) {
+      first += half + 1;
+      count -= half + 1;
+    } else if (is_duplicate(middle, record)) {
+      return true;
+    } else {
+      count = half;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Reads the records of a spill file in order, `buffer_size` records at a time.
+ */
+template <typename Record>
+class RecordReader {
+public:
+  RecordReader(const std::filesystem::path& path, std::size_t buffer_size)
+      : m_file{path, std::ios::binary}
+      , m_buffer_size{std::max<std::size_t>(buffer_size, 1)} {}
+
+  /**
+   * Reads the next record into `record`. Returns `true` if successful, otherwise (i.e., at the end
+   * of the file, or if it could not be read) `false`.
+   */
+  bool next(Record& record) {
+    if (m_pos == m_buffer.size()) {
+      m_buffer.resize(m_buffer_size);
+      m_file.read(
+          reinterpret_cast<char*>(m_buffer.data()),
+          static_cast<std::streamsize>(m_buffer_size * sizeof(Record))
+      );
+      m_buffer.resize(static_cast<std::size_t>(m_file.gcount()) / sizeof(Record));
+      m_pos = 0;
+
+      if (m_buffer.empty()) {
+        return false;
+      }
+    }
+
+    record = m_buffer[m_pos++];
+    return true;
+  }
+
+  /**
+   * Returns `false` if the file could not be opened or read.
+   */
+  bool is_ok() const {
+    return m_file.is_open() && !m_file.bad();
+  }
+
+private:
+  std::ifstream m_file;
+  std::size_t m_buffer_size;
+  std::vector<Record> m_buffer{};
+  std::size_t m_pos{0};
+};
+
+/**
+ * Writes records to the end of a spill file, `buffer_size` records at a time.
+ */
+template <typename Record>
+class RecordWriter {
+public:
+  RecordWriter(const std::filesystem::path& path, std::size_t buffer_size)
+      : m_file{path, std::ios::binary | std::ios::app}
+      , m_buffer_size{std::max<std::size_t>(buffer_size, 1)} {
+    m_buffer.reserve(m_buffer_size);
+  }
+
+  void write(const Record& record) {
+    m_buffer.push_back(record);
+
+    if (m_buffer.size() == m_buffer_size) {
+      flush();
+    }
+  }
+
+  /**
+   * Writes all buffered records. Returns `true` if every record written so far was written
+   * successfully, otherwise `false`.
+   */
+  bool flush() {
+    m_file.write(
+        reinterpret_cast<const char*>(m_buffer.data()),
+        static_cast<std::streamsize>(m_buffer.size() * sizeof(Record))
+    );
+    m_buffer.clear();
+    m_file.flush();
+
+    return m_file.good();
+  }
+
+private:
+  std::ofstream m_file;
+  std::size_t m_buffer_size;
+  std::vector<Record> m_buffer{};
+};
+
+template <int Width, int Height>
+class ExternalAstar {
+public:
+  ExternalAstar(const Problem<Width, Height>& problem, const AstarOptions& options);
+  ExternalAstar(const ExternalAstar&) = delete;
+  ExternalAstar& operator=(const ExternalAstar&) = delete;
+  ~ExternalAstar();
+
+  void run(AstarResult& result);
+
+private:
+  using Grid = ::Grid<Width, Height>;
+  using Record = ::Record<Width, Height>;
+  static_assert(std::is_trivially_copyable_v<Record>);
+
+  /**
+   * A sorted file of grid states, without duplicates.
+   */
+  struct SortedFile {
+    std::filesystem::path path;
+    std::size_t num_records;
+  };
+
+  /**
+   * A sorted file of grid states that were not in a bucket's closed list when it was closed.
+   */
+  struct FreshFile {
+    std::filesystem::path path;
+    std::size_t num_records;
+    // Number of records, from the start of the file, that have been expanded
+    std::size_t num_expanded{0};
+    // Reads the records to expand, opened once the first is, so that each bucket streams 1 file
+    std::optional<RecordReader<Record>> reader{};
+  };
+
+  /**
+   * Grid states with a given f and g.
+   */
+  struct Bucket {
+    // Records not yet written to `open_path`
+    std::vector<Record> buffer{};
+    // Unsorted records added since the bucket was last closed, or empty if none
+    std::filesystem::path open_path{};
+    // Sorted runs of the grid states closed so far, each holding over twice as many records as
+    // the next (see `compact()`), where no grid state is in more than 1 run
+    std::vector<SortedFile> closed_runs{};
+    // Closed grid states that have not all been expanded yet, oldest first
+    std::deque<FreshFile> fresh_files{};
+
+    /**
+     * Returns `true` if records have been added since the bucket was last closed.
+     */
+    bool has_added() const {
+      return !buffer.empty() || !open_path.empty();
+    }
+
+    /**
+     * Returns `true` if the bucket has grid states that have not been expanded yet.
+     */
+    bool is_open() const {
+      return has_added() || !fresh_files.empty();
+    }
+  };
+
+  const Problem<Width, Height>& m_problem;
+  AstarOptions m_options;
+  Stats m_stats{};
+
+  // Directory holding every spill file of the search, or empty if it could not be created
+  std::filesystem::path m_dir{};
+  // Number of records written to disk at a time, and held by each sorted run
+  std::size_t m_buffer_records;
+  std::size_t m_run_records;
+  std::size_t m_num_files{0};
+
+  // Buckets in the order they are expanded, keyed by f and g (see `bucket_key()`)
+  std::map<std::pair<int, int>, Bucket> m_buckets{};
+  std::size_t m_num_buffered{0};
+  bool m_is_io_error{false};
+
+  /**
+   * Returns the key in `m_buckets` of the bucket of grid states with the given f and g, which sorts
+   * buckets by f, then by g in descending order, or ascending order with
+   * `TieBreaking::ShallowestFirst`.
+   */
+  std::pair<int, int> bucket_key(int f, int g) const;
+
+  /**
+   * Returns the g of the grid states in the bucket with the given key in `m_buckets`.
+   */
+  int bucket_g(const std::pair<int, int>& key) const;
+
+  /**
+   * Adds `grid`, whose most recently placed tetromino is `move`, to its bucket.
+   */
+  void add(const Grid& grid, Move move);
+
+  /**
+   * Writes `bucket`'s buffered records to its file.
+   */
+  void flush(Bucket& bucket);
+
+  /**
+   * Writes every bucket's buffered records to its file.
+   */
+  void flush_all();
+
+  /**
+   * Merges the sorted `files` into a sorted file at `merged_path`, dropping duplicates, using at
+   * most the memory of a sorted run. Returns the number of records written.
+   */
+  std::size_t merge(const std::vector<SortedFile>& files, const std::filesystem::path& merged_path);
+
+  /**
+   * Sorts the records added to `bucket` since it was last closed, dropping duplicates, then returns
+   * the path of the sorted file.
+   */
+  std::filesystem::path sort(Bucket& bucket);
+
+  /**
+   * Adds the records added to `bucket` since it was last closed that were not already in its closed
+   * list to its fresh files, and to its closed list as a new run.
+   */
+  void close(Bucket& bucket);
+
+  /**
+   * Merges the newest 2 runs of `bucket`'s closed list until each run holds over twice as many
+   * records as the next, so that a bucket closed n times has O(log n) runs, and each record is
+   * rewritten O(log n) times.
+   */
+  void compact(Bucket& bucket);
+
+  /**
+   * Removes the spill file at `path` unless it is still a closed run or fresh file of `bucket`.
+   */
+  void remove_if_unused(const Bucket& bucket, const std::filesystem::path& path);
+
+  /**
+   * Reads the next grid state of `bucket`'s oldest fresh file into `record`, after which it counts
+   * as expanded. Returns `true` if successful, otherwise `false`.
+   */
+  bool next_fresh(Bucket& bucket, Record& record);
+
+  /**
+   * Expands the next grid state of `bucket`'s oldest fresh file, whose grid has actual cost `g`.
+   */
+  void expand(Bucket& bucket, int g);
+
+  /**
+   * Returns the tetrominoes placed along the path to `goal`, which has actual cost `g`, in order.
+   */
+  std::vector<std::array<Position, Tetromino::SIZE>> reconstruct_path(Record goal, int g);
+
+  /**
+   * Returns a new path in the search's directory for a spill file.
+   */
+  std::filesystem::path temp_path(const std::string& name);
+};
+
+template <int Width, int Height>
+ExternalAstar<Width, Height>::ExternalAstar(
+    const Problem<Width, Height>& problem, const AstarOptions& options
+)
+    : m_problem{problem}
+    , m_options{options}
+    , m_buffer_records{std::max<std::size_t>(options.memory_limit_bytes / 2 / sizeof(Record), 1)}
+    , m_run_records{m_buffer_records} {
+  std::error_code error{};
+  std::filesystem::path parent{
+      options.spill_dir.empty() ? std::filesystem::temp_directory_path(error)
+                                 : std::filesystem::path{options.spill_dir}
+  };
+
+  // Concurrent searches (e.g., of a batch) each have a directory of their own
+  std::random_device random_device{};
+  std::mt19937_64 random{(std::uint64_t{random_device()} << 32) | random_device()};
+  auto dir{parent / ("tetromino_astar-" + std::to_string(random()))};
+
+  if (!error && std::filesystem::create_directories(dir, error)) {
+    m_dir = dir;
+  }
+}
+
+template <int Width, int Height>
+ExternalAstar<Width, Height>::~ExternalAstar() {
+  if (!m_dir.empty()) {
+    std::error_code error{};
+    std::filesystem::remove_all(m_dir, error);
+  }
+}
+
+template <int Width, int Height>
+void ExternalAstar<Width, Height>::run(AstarResult& result) {
+  if (m_dir.empty()) {
+    result.is_io_error = true;
+    return;
+  }
+
+  Grid root{m_problem, m_options.placement_rule};
+
+  if (m_options.heuristic == Heuristic::FloodFill) {
+    root.raise_to_flood_fill_heuristic();
+  }
+
+  add(root, {-1, {0, 0}});
+
+  while (!m_is_io_error) {
+    auto it{std::ranges::find_if(m_buckets, [](const auto& entry) {
+      return entry.second.is_open();
+    })};
+
+    if (it == m_buckets.end()) {
+      break;
+    }
+
+    auto f{it->first.first};
+    auto g{bucket_g(it->first)};
+    auto& bucket{it->second};
+
+    if (bucket.has_added()) {
+      close(bucket);
+    }
+
+    if (bucket.fresh_files.empty()) {
+      continue;
+    }
+
+    // Grids whose h is 0 have reached the target position, and since no open bucket has a lower
+    // f, they were reached optimally
+    if (f == g) {
+      Record goal{};
+
+      if (next_fresh(bucket, goal)) {
+        result.is_solved = true;
+        result.path = reconstruct_path(goal, g);
+        result.cost = g;
+        break;
+      }
+    } else {
+      expand(bucket, g);
+    }
+  }
+
+  result.is_io_error = m_is_io_error;
+
+  if (m_is_io_error) {
+    result.is_solved = false;
+    result.path.clear();
+    result.cost = 0;
+  }
+
+  result.stats = m_stats;
+}
+
+template <int Width, int Height>
+std::pair<int, int> ExternalAstar<Width, Height>::bucket_key(int f, int g) const {
+  return {f, m_options.tie_breaking == TieBreaking::ShallowestFirst ? g : -g};
+}
+
+template <int Width, int Height>
+int ExternalAstar<Width, Height>::bucket_g(const std::pair<int, int>& key) const {
+  return m_options.tie_breaking == TieBreaking::ShallowestFirst ? key.second : -key.second;
+}
+
+template <int Width, int Height>
+void ExternalAstar<Width, Height>::add(const Grid& grid, Move move) {
+  auto& bucket{m_buckets[bucket_key(grid.g() + grid.h(), grid.g())]};
+
+  bucket.buffer.push_back(
+      {grid.hash(),
+       grid.variant(),
+       static_cast<std::int16_t>(move.tetromino),
+       static_cast<std::int16_t>(
+           move.tetromino < 0 ? 0 : FlatBitGrid<Width, Height>::index(move.anchor)
+       ),
+       grid.placements()}
+  );
+
+  if (++m_num_buffered >= m_buffer_records) {
+    flush_all();
+  }
+}
+
+template <int Width, int Height>
+void ExternalAstar<Width, Height>::flush(Bucket& bucket) {
+  if (bucket.buffer.empty()) {
+    return;
+  }
+
+  if (bucket.open_path.empty()) {
+    bucket.open_path = temp_path("open");
+  }
+
+  std::ofstream file{bucket.open_path, std::ios::binary | std::ios::app};
+  file.write(
+      reinterpret_cast<const char*>(bucket.buffer.data()),
+      static_cast<std::streamsize>(bucket.buffer.size() * sizeof(Record))
+  );
+  m_is_io_error |= !file.good();
+
+  m_num_buffered -= bucket.buffer.size();
+
+  // Release the buffer's memory, since most buckets are not added to again for a while
+  std::vector<Record>{}.swap(bucket.buffer);
+}
+
+template <int Width, int Height>
+void ExternalAstar<Width, Height>::flush_all() {
+  for (auto& [key, bucket] : m_buckets) {
+    flush(bucket);
+  }
+}
+
+template <int Width, int Height>
+std::size_t ExternalAstar<Width, Height>::merge(
+    const std::vector<SortedFile>& files, const std::filesystem::path& merged_path
+) {
+  // The memory of a run is split between the readers of each file and the writer, though no
+  // buffer is larger than the records it is for
+  auto buffer_records{m_run_records / (files.size() + 1)};
+  std::size_t total_records{0};
+
+  for (const auto& file : files) {
+    total_records += file.num_records;
+  }
+
+  std::vector<RecordReader<Record>> readers{};
+  RecordWriter<Record> writer{merged_path, std::min(buffer_records, total_records)};
+  std::size_t num_records{0};
+
+  auto is_after{[](const std::pair<Record, std::size_t>& lhs,
+                   const std::pair<Record, std::size_t>& rhs) {
+    return is_before(rhs.first, lhs.first);
+  }};
+  std::priority_queue<
+      std::pair<Record, std::size_t>,
+      std::vector<std::pair<Record, std::size_t>>,
+      decltype(is_after)>
+      heads{is_after};
+
+  readers.reserve(files.size());
+
+  for (std::size_t i{0}; i < files.size(); ++i) {
+    auto& reader{
+        readers.emplace_back(files[i].path, std::min(buffer_records, files[i].num_records))
+    };
+    Record head{};
+
+    if (reader.next(head)) {
+      heads.emplace(head, i);
+    }
+  }
+
+  Record last{};
+
+  while (!heads.empty()) {
+    auto [record, i]{heads.top()};
+    heads.pop();
+
+    if (num_records > 0 && is_duplicate(last, record)) {
+      ++m_stats.revisited;
+    } else {
+      writer.write(record);
+      last = record;
+      ++num_records;
+    }
+
+    if (Record next{}; readers[i].next(next)) {
+      heads.emplace(next, i);
+    }
+  }
+
+  m_is_io_error |= !writer.flush();
+
+  for (const auto& reader : readers) {
+    m_is_io_error |= !reader.is_ok();
+  }
+
+  return num_records;
+}
+
+template <int Width, int Height>
+std::filesystem::path ExternalAstar<Width, Height>::sort(Bucket& bucket) {
+  auto sorted_path{temp_path("sorted")};
+
+  // Records that have not been written yet are sorted as is, which is typical of small buckets
+  if (bucket.open_path.empty()) {
+    auto& records{bucket.buffer};
+    m_num_buffered -= records.size();
+    std::ranges::sort(records, is_before<Width, Height>);
+    auto duplicates{std::ranges::unique(records, is_duplicate<Width, Height>)};
+    m_stats.revisited += static_cast<int>(duplicates.size());
+    records.erase(duplicates.begin(), duplicates.end());
+
+    std::ofstream file{sorted_path, std::ios::binary};
+    file.write(
+        reinterpret_cast<const char*>(records.data()),
+        static_cast<std::streamsize>(records.size() * sizeof(Record))
+    );
+    m_is_io_error |= !file.good();
+
+    std::vector<Record>{}.swap(records);
+
+    return sorted_path;
+  }
+
+  flush(bucket);
+
+  std::error_code error{};
+  auto num_records{std::filesystem::file_size(bucket.open_path, error) / sizeof(Record)};
+  m_is_io_error |= static_cast<bool>(error);
+
+  // Each run is sorted in memory, and duplicates within it dropped, before being written
+  std::vector<SortedFile> runs{};
+
+  {
+    std::ifstream file{bucket.open_path, std::ios::binary};
+    std::vector<Record> run{};
+
+    for (std::size_t remaining{num_records}; remaining > 0 && file.good();) {
+      run.resize(std::min(remaining, m_run_records));
+      file.read(
+          reinterpret_cast<char*>(run.data()),
+          static_cast<std::streamsize>(run.size() * sizeof(Record))
+      );
+      remaining -= run.size();
+
+      std::ranges::sort(run, is_before<Width, Height>);
+      auto duplicates{std::ranges::unique(run, is_duplicate<Width, Height>)};
+      m_stats.revisited += static_cast<int>(duplicates.size());
+      run.erase(duplicates.begin(), duplicates.end());
+
+      const auto& run_path{runs.emplace_back(temp_path("run"), run.size()).path};
+      std::ofstream run_file{run_path, std::ios::binary};
+      run_file.write(
+          reinterpret_cast<const char*>(run.data()),
+          static_cast<std::streamsize>(run.size() * sizeof(Record))
+      );
+      m_is_io_error |= !run_file.good();
+    }
+
+    m_is_io_error |= !file.good();
+  }
+
+  std::filesystem::remove(bucket.open_path, error);
+  bucket.open_path.clear();
+
+  if (runs.size() == 1) {
+    return runs.front().path;
+  }
+
+  // Otherwise the runs are merged, dropping duplicates across runs
+  merge(runs, sorted_path);
+
+  for (const auto& run : runs) {
+    std::filesystem::remove(run.path, error);
+  }
+
+  return sorted_path;
+}
+
+template <int Width, int Height>
+void ExternalAstar<Width, Height>::close(Bucket& bucket) {
+  auto sorted_path{sort(bucket)};
+  std::error_code error{};
+
+  // Most buckets are only closed once, so their sorted records become their closed list as is
+  if (bucket.closed_runs.empty()) {
+    auto num_records{std::filesystem::file_size(sorted_path, error) / sizeof(Record)};
+    m_is_io_error |= static_cast<bool>(error);
+    bucket.closed_runs.push_back({sorted_path, num_records});
+
+    if (num_records > 0) {
+      bucket.fresh_files.push_back({sorted_path, num_records});
+    }
+
+    return;
+  }
+
+  /**
+   * Otherwise the sorted records are compared with every run of the closed list at once, and only
+   * those in none of them are kept. Since the runs hold different grid states, they are not
+   * rewritten, and the records kept become a new run. Runs far larger than the sorted records are
+   * binary searched for each record instead of being read in full, since a bucket is often closed
+   * again for only a few records.
+   */
+  auto num_sorted{std::filesystem::file_size(sorted_path, error) / sizeof(Record)};
+  m_is_io_error |= static_cast<bool>(error);
+
+  std::vector<SortedFile> scanned_runs{};
+  std::vector<std::pair<std::ifstream, std::size_t>> searched_runs{};
+
+  for (const auto& run : bucket.closed_runs) {
+    if (num_sorted * std::bit_width(run.num_records) * RECORDS_PER_SEEK < run.num_records) {
+      auto& [file, num_records]{searched_runs.emplace_back(std::ifstream{}, run.num_records)};
+
+      // Unbuffered, so that each step of a binary search only reads its record
+      file.rdbuf()->pubsetbuf(nullptr, 0);
+      file.open(run.path, std::ios::binary);
+    } else {
+      scanned_runs.push_back(run);
+    }
+  }
+
+  // As in `merge()`, no buffer is larger than the records it is for
+  auto buffer_records{m_run_records / (scanned_runs.size() + 2)};
+  auto fresh_path{temp_path("fresh")};
+  std::size_t num_fresh{0};
+
+  {
+    RecordReader<Record> sorted{sorted_path, std::min(buffer_records, num_sorted)};
+    RecordWriter<Record> fresh_writer{fresh_path, std::min(buffer_records, num_sorted)};
+    std::vector<RecordReader<Record>> scanned{};
+    std::vector<Record> heads(scanned_runs.size());
+    std::vector<bool> has_heads(scanned_runs.size());
+
+    scanned.reserve(scanned_runs.size());
+
+    for (std::size_t i{0}; i < scanned_runs.size(); ++i) {
+      scanned.emplace_back(
+          scanned_runs[i].path, std::min(buffer_records, scanned_runs[i].num_records)
+      );
+      has_heads[i] = scanned[i].next(heads[i]);
+    }
+
+    for (Record record{}; sorted.next(record);) {
+      bool is_closed{false};
+
+      for (std::size_t i{0}; i < scanned.size(); ++i) {
+        while (has_heads[i] && is_before(heads[i], record)) {
+          has_heads[i] = scanned[i].next(heads[i]);
+        }
+
+        is_closed |= has_heads[i] && is_duplicate(heads[i], record);
+      }
+
+      for (auto& [file, num_records] : searched_runs) {
+        is_closed = is_closed || has_duplicate(file, num_records, record);
+      }
+
+      if (is_closed) {
+        ++m_stats.revisited;
+      } else {
+        fresh_writer.write(record);
+        ++num_fresh;
+      }
+    }
+
+    m_is_io_error |= !sorted.is_ok() || !fresh_writer.flush();
+
+    for (const auto& reader : scanned) {
+      m_is_io_error |= !reader.is_ok();
+    }
+
+    for (const auto& [file, num_records] : searched_runs) {
+      m_is_io_error |= !file;
+    }
+  }
+
+  std::filesystem::remove(sorted_path, error);
+
+  if (num_fresh == 0) {
+    std::filesystem::remove(fresh_path, error);
+    return;
+  }
+
+  bucket.closed_runs.push_back({fresh_path, num_fresh});
+  bucket.fresh_files.push_back({fresh_path, num_fresh});
+  compact(bucket);
+}
+
+template <int Width, int Height>
+void ExternalAstar<Width, Height>::compact(Bucket& bucket) {
+  auto& runs{bucket.closed_runs};
+
+  while (runs.size() >= 2 && runs.back().num_records * 2 >= runs[runs.size() - 2].num_records) {
+    auto older{runs[runs.size() - 2]};
+    auto newer{runs.back()};
+    runs.resize(runs.size() - 2);
+
+    auto merged_path{temp_path("closed")};
+    auto num_records{merge({older, newer}, merged_path)};
+    runs.push_back({merged_path, num_records});
+
+    remove_if_unused(bucket, older.path);
+    remove_if_unused(bucket, newer.path);
+  }
+}
+
+template <int Width, int Height>
+void ExternalAstar<Width, Height>::remove_if_unused(
+    const Bucket& bucket, const std::filesystem::path& path
+) {
+  auto has_path{[&path](const auto& file) {
+    return file.path == path;
+  }};
+
+  if (std::ranges::none_of(bucket.closed_runs, has_path)
+      && std::ranges::none_of(bucket.fresh_files, has_path)) {
+    std::error_code error{};
+    std::filesystem::remove(path, error);
+  }
+}
+
+template <int Width, int Height>
+bool ExternalAstar<Width, Height>::next_fresh(Bucket& bucket, Record& record) {
+  auto& fresh_file{bucket.fresh_files.front()};
+
+  if (!fresh_file.reader) {
+    fresh_file.reader.emplace(fresh_file.path, EXPAND_BUFFER_BYTES / sizeof(Record));
+  }
+
+  if (!fresh_file.reader->next(record)) {
+    m_is_io_error = true;
+    return false;
+  }
+
+  if (++fresh_file.num_expanded == fresh_file.num_records) {
+    // Each fresh file is also a run of the closed list until it is merged with another
+    auto path{fresh_file.path};
+    bucket.fresh_files.pop_front();
+    remove_if_unused(bucket, path);
+  }
+
+  return true;
+}
+
+template <int Width, int Height>
+void ExternalAstar<Width, Height>::expand(Bucket& bucket, int g) {
+  Record record{};
+
+  if (!next_fresh(bucket, record)) {
+    return;
+  }
+
+  Grid grid{m_problem, record.placements, g, record.move(), m_options.placement_rule};
+
+  /**
+   * Unlike in `astar()`, the flood-fill heuristic is calculated for every generated grid, before it
+   * is stored, rather than only for grids about to be expanded. Since `grid` is restored without
+   * its raised estimated cost, a successor's h then depends only on its grid state, so duplicates
+   * still share a bucket.
+   */
+  for (auto move : grid.moves()) {
+    ++m_stats.generated;
+    auto successor{grid.successor(move)};
+
+    if (m_options.heuristic == Heuristic::FloodFill) {
+      successor.raise_to_flood_fill_heuristic();
+
+      if (successor.is_target_unreachable()) {
+        ++m_stats.pruned;
+        continue;
+      }
+    }
+
+    add(successor, move);
+  }
+
+  ++m_stats.expanded;
+}
+
+template <int Width, int Height>
+std::vector<std::array<Position, Tetromino::SIZE>>
+ExternalAstar<Width, Height>::reconstruct_path(Record goal, int g) {
+  std::vector<std::array<Position, Tetromino::SIZE>> path{};
+
+  for (auto record{goal}; g > 0; --g) {
+    auto move{record.move()};
+    auto& positions{path.emplace_back()};
+    auto parent_placements{record.placements};
+
+    std::ranges::transform(
+        FIXED_TETROMINOES[move.tetromino].pieces, positions.begin(), [move](Position piece) {
+          return Position{move.anchor.x + piece.x, move.anchor.y + piece.y};
+        }
+    );
+
+    for (auto pos : positions) {
+      parent_placements.clear(pos);
+    }
+
+    // The parent is in the closed list of a bucket of the layer before, with its placements, and
+    // with `PlacementRule::Chain`, a chain end that `move` extends
+    auto is_parent{[&](const Record& candidate) {
+      if (!(candidate.placements == parent_placements)) {
+        return false;
+      }
+
+      if (m_options.placement_rule != PlacementRule::Chain) {
+        return true;
+      }
+
+      Grid parent{
+          m_problem, candidate.placements, g - 1, candidate.move(), m_options.placement_rule
+      };
+
+      return std::ranges::any_of(parent.moves(), [move](Move other) {
+        return other.tetromino == move.tetromino && other.anchor == move.anchor;
+      });
+    }};
+
+    bool is_found{false};
+
+    for (const auto& [key, bucket] : m_buckets) {
+      if (bucket_g(key) != g - 1) {
+        continue;
+      }
+
+      for (const auto& run : bucket.closed_runs) {
+        RecordReader<Record> reader{run.path, READ_BUFFER_BYTES / sizeof(Record)};
+
+        for (Record candidate{}; !is_found && reader.next(candidate);) {
+          if (is_parent(candidate)) {
+            record = candidate;
+            is_found = true;
+          }
+        }
+
+        m_is_io_error |= !reader.is_ok();
+
+        if (is_found) {
+          break;
+        }
+      }
+
+      if (is_found) {
+        break;
+      }
+    }
+
+    if (!is_found) {
+      m_is_io_error = true;
+      return {};
+    }
+  }
+
+  std::ranges::reverse(path);
+  return path;
+}
+
+template <int Width, int Height>
+std::filesystem::path ExternalAstar<Width, Height>::temp_path(const std::string& name) {
+  return m_dir / (name + "-" + std::to_string(m_num_files++) + ".bin");
+}
+}
+
+template <int Width, int Height>
+AstarResult external_astar(const Problem<Width, Height>& problem, const AstarOptions& options) {
+  auto start_time{std::chrono::steady_clock::now()};
+  AstarResult result{};
+
+  if (!problem.is_target_enclosed()) {
+    ExternalAstar<Width, Height>{problem, options}.run(result);
+  }
+
+  auto finish_time{std::chrono::steady_clock::now()};
+  result.elapsed_secs
+      = std::chrono::duration_cast<std::chrono::duration<double>>(finish_time - start_time).count();
+
+  return result;
+}
+
+#define INSTANTIATE_EXTERNAL_ASTAR(width, height)                                                 \
+  template AstarResult external_astar<width, height>(                                             \
+      const Problem<width, height>& problem, const AstarOptions& options                          \
+  );
+FOR_EACH_GRID_DIMENSIONS(INSTANTIATE_EXTERNAL_ASTAR)
+#undef INSTANTIATE_EXTERNAL_ASTAR
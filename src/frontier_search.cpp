@@ -0,0 +1,256 @@
+#include "../include/frontier_search.h"
+#include "../include/ClosedSet.h"
+#include "../include/Grid.h"
+#include "../include/GridDimensions.h"
+#include "../include/Node.h"
+#include "../include/NodeStore.h"
+#include "../include/OpenList.h"
+#include "../include/Position.h"
+#include "../include/Problem.h"
+#include "../include/Tetromino.h"
+#include "../include/astar.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace {
+template <int Width, int Height>
+class FrontierSearch {
+public:
+  FrontierSearch(const Problem<Width, Height>& problem, const AstarOptions& options);
+
+  void run(AstarResult& result);
+
+private:
+  using Grid = ::Grid<Width, Height>;
+  using Path = std::vector<std::array<Position, Tetromino::SIZE>>;
+
+  // Number of grids each layer's closed set holds before it first grows, which is kept small
+  // since most layers hold few grids
+  static constexpr std::size_t LAYER_CLOSED_SET_CAPACITY{std::size_t{1} << 10};
+
+  /**
+   * Stores the outcome of `search()`.
+   */
+  struct Segment {
+    // Grid at which the search ended, or empty if no path was found
+    std::optional<Grid> last{};
+    // Ancestor of `last` in the midpoint layer, or empty if `last` is before it
+    std::optional<Grid> relay{};
+  };
+
+  const Problem<Width, Height>& m_problem;
+  AstarOptions m_options;
+  Stats m_stats{};
+
+  /**
+   * Searches from `first` for the nearest grid that has reached the target position or, if `goal`
+   * is not null, for grid `*goal`, only placing tetrominoes on positions where `*goal` has a piece.
+   */
+  Segment search(const Grid& first, const Grid* goal);
+
+  /**
+   * Appends the tetrominoes placed along an optimal path from `first` to the nearest grid that has
+   * reached the target position or, if `goal` is not null, to grid `*goal`, to `path`. Returns
+   * `true` if such a path exists, otherwise `false`.
+   */
+  bool solve(const Grid& first, const Grid* goal, Path& path);
+};
+
+template <int Width, int Height>
+FrontierSearch<Width, Height>::FrontierSearch(
+    const Problem<Width, Height>& problem, const AstarOptions& options
+)
+    : m_problem{problem}
+    , m_options{options} {}
+
+template <int Width, int Height>
+void FrontierSearch<Width, Height>::run(AstarResult& result) {
+  if (solve(Grid{m_problem, m_options.placement_rule}, nullptr, result.path)) {
+    result.is_solved = true;
+    result.cost = static_cast<int>(result.path.size());
+  }
+
+  result.stats = m_stats;
+}
+
+template <int Width, int Height>
+typename FrontierSearch<Width, Height>::Segment
+FrontierSearch<Width, Height>::search(const Grid& first, const Grid* goal) {
+  // Every grid on the way to `goal` is a subset of it, so the cost to it is known exactly, and
+  // all nodes have equal f
+  auto h{[goal](const Grid& grid) { return goal ? goal->g() - grid.g() : grid.h(); }};
+  auto relay_g{first.g() + std::max(h(first) / 2, 1)};
+
+  NodeStore<Width, Height> store{};
+  // Grids of the midpoint layer that have been expanded, which `store`'s nodes refer to instead
+  // of their parents
+  NodeStore<Width, Height> relays{};
+
+  // Closed set and number of open nodes of each layer, indexed by g relative to `first`
+  std::vector<std::optional<ClosedSet<Width, Height>>> closed_sets{};
+  std::vector<int> num_open{};
+  // Layers before `lowest_open_layer` have no open nodes, and layers before `num_dropped_layers`
+  // no longer have a closed set
+  std::size_t lowest_open_layer{0};
+  std::size_t num_dropped_layers{0};
+
+  OpenList open_list{goal ? TieBreaking::DeepestFirst : m_options.tie_breaking};
+
+  auto push{[&](const Grid& grid, NodeId relay) {
+    auto layer{static_cast<std::size_t>(grid.g() - first.g())};
+
+    if (layer >= num_open.size()) {
+      num_open.resize(layer + 1, 0);
+    }
+
+    ++num_open[layer];
+    open_list.push(store.add(grid, relay), grid.g() + h(grid), grid.g());
+  }};
+
+  auto is_new{[&](const Grid& grid) {
+    auto layer{static_cast<std::size_t>(grid.g() - first.g())};
+
+    if (layer >= closed_sets.size()) {
+      closed_sets.resize(layer + 1);
+    }
+
+    auto& closed_set{closed_sets[layer]};
+
+    if (!closed_set) {
+      closed_set.emplace(
+          LAYER_CLOSED_SET_CAPACITY, m_options.placement_rule == PlacementRule::Chain
+      );
+    }
+
+    return closed_set->insert(grid.placements(), grid.hash(), grid.variant());
+  }};
+
+  is_new(first);
+  push(first, NO_NODE);
+
+  while (!open_list.empty()) {
+    auto id{open_list.pop()};
+
+    // The node is removed before it is expanded, so its slot can be reused by its successors
+    Grid grid{store[id].grid()};
+    auto relay{store[id].parent()};
+    store.remove(id);
+    --num_open[grid.g() - first.g()];
+
+    // As in `astar()`, the flood-fill heuristic is only calculated for nodes about to be expanded
+    if (!goal && m_options.heuristic == Heuristic::FloodFill
+        && grid.raise_to_flood_fill_heuristic()) {
+      if (grid.is_target_unreachable()) {
+        ++m_stats.pruned;
+      } else {
+        push(grid, relay);
+      }
+
+      continue;
+    }
+
+    if (goal ? grid.g() == goal->g() : grid.is_target_reached()) {
+      Segment segment{grid};
+
+      if (relay != NO_NODE) {
+        segment.relay = relays[relay].grid();
+      }
+
+      return segment;
+    }
+
+    if (grid.g() == relay_g) {
+      relay = relays.add(grid, NO_NODE);
+    }
+
+    for (auto move : grid.moves()) {
+      if (goal) {
+        const auto& pieces{FIXED_TETROMINOES[move.tetromino].pieces};
+
+        if (!std::ranges::all_of(pieces, [&](Position piece) {
+              return goal->placements().is_set(
+                  {move.anchor.x + piece.x, move.anchor.y + piece.y}
+              );
+            })) {
+          continue;
+        }
+      }
+
+      auto successor{grid.successor(move)};
+      ++m_stats.generated;
+
+      if (is_new(successor)) {
+        push(successor, relay);
+      } else {
+        ++m_stats.revisited;
+      }
+    }
+
+    ++m_stats.expanded;
+
+    // A layer can only be generated from the layer before it, so once no node before a layer
+    // remains open, duplicates of its grids can no longer be generated
+    while (lowest_open_layer < num_open.size() && num_open[lowest_open_layer] == 0) {
+      ++lowest_open_layer;
+    }
+
+    for (; num_dropped_layers <= lowest_open_layer && num_dropped_layers < closed_sets.size();
+         ++num_dropped_layers) {
+      closed_sets[num_dropped_layers].reset();
+    }
+  }
+
+  return {};
+}
+
+template <int Width, int Height>
+bool FrontierSearch<Width, Height>::solve(const Grid& first, const Grid* goal, Path& path) {
+  auto segment{search(first, goal)};
+
+  if (!segment.last) {
+    return false;
+  }
+
+  const auto& last{*segment.last};
+
+  if (last.g() - first.g() <= 1) {
+    if (last.g() > first.g()) {
+      path.push_back(last.difference(first));
+    }
+
+    return true;
+  }
+
+  // The relay lies on an optimal path, strictly between `first` and `last`, so both halves are
+  // found by searches towards a known grid
+  const auto& relay{*segment.relay};
+  return solve(first, &relay, path) && solve(relay, &last, path);
+}
+}
+
+template <int Width, int Height>
+AstarResult frontier_search(const Problem<Width, Height>& problem, const AstarOptions& options) {
+  auto start_time{std::chrono::steady_clock::now()};
+  AstarResult result{};
+
+  if (!problem.is_target_enclosed()) {
+    FrontierSearch<Width, Height>{problem, options}.run(result);
+  }
+
+  auto finish_time{std::chrono::steady_clock::now()};
+  result.elapsed_secs
+      = std::chrono::duration_cast<std::chrono::duration<double>>(finish_time - start_time).count();
+
+  return result;
+}
+
+#define INSTANTIATE_FRONTIER_SEARCH(width, height)                                                \
+  template AstarResult frontier_search<width, height>(                                            \
+      const Problem<width, height>& problem, const AstarOptions& options                          \
+  );
+FOR_EACH_GRID_DIMENSIONS(INSTANTIATE_FRONTIER_SEARCH)
+#undef INSTANTIATE_FRONTIER_SEARCH
@@ -0,0 +1,88 @@
+#include "../include/generator.h"
+#include "../include/GridDimensions.h"
+#include "../include/Position.h"
+#include "../include/astar.h"
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <random>
+
+namespace {
+/**
+ * Returns a random integer in [0, `bound`), with negligible bias for small bounds.
+ */
+int random_below(std::mt19937_64& rng, int bound) {
+  return static_cast<int>(rng() % static_cast<std::uint64_t>(bound));
+}
+
+/**
+ * Returns a random real number in [0, 1), from the top 53 bits of a draw.
+ */
+double random_unit(std::mt19937_64& rng) {
+  return static_cast<double>(rng() >> 11) * 0x1.0p-53;
+}
+
+Position random_position(std::mt19937_64& rng, int width, int height) {
+  return {random_below(rng, width), random_below(rng, height)};
+}
+}
+
+std::optional<AstarParams> generate_puzzle(const GeneratorParams& params, std::uint64_t index) {
+  if (params.width < 1 || params.width > MAX_GRID_WIDTH || params.height < 1
+      || params.height > MAX_GRID_HEIGHT || params.width * params.height < 2) {
+    return std::nullopt;
+  }
+
+  // The algorithm of `std::seed_seq` is fixed by the standard, unlike those of distributions
+  std::seed_seq seed_sequence{
+      static_cast<std::uint32_t>(params.seed),
+      static_cast<std::uint32_t>(params.seed >> 32),
+      static_cast<std::uint32_t>(index),
+      static_cast<std::uint32_t>(index >> 32)
+  };
+  std::mt19937_64 rng{seed_sequence};
+
+  for (int attempt{0}; attempt < MAX_GENERATOR_ATTEMPTS; ++attempt) {
+    AstarParams puzzle{params.width, params.height, {}, {}, {}};
+    puzzle.start = random_position(rng, params.width, params.height);
+    puzzle.target = random_position(rng, params.width, params.height);
+
+    auto distance{
+        std::abs(puzzle.start.x - puzzle.target.x) + std::abs(puzzle.start.y - puzzle.target.y)
+    };
+
+    if (distance == 0 || distance < params.min_distance) {
+      continue;
+    }
+
+    for (int y{0}; y < params.height; ++y) {
+      for (int x{0}; x < params.width; ++x) {
+        Position pos{x, y};
+
+        // Drawn for every position, so that the obstacles do not shift with the start and target
+        // positions
+        auto is_obstacle{random_unit(rng) < params.obstacle_density};
+
+        if (is_obstacle && pos != puzzle.start && pos != puzzle.target) {
+          puzzle.obstacles.push_back(pos);
+        }
+      }
+    }
+
+    auto is_accepted{with_problem(puzzle, [&params](const auto& problem) {
+      if (problem.is_target_enclosed()) {
+        return false;
+      }
+
+      auto estimated_cost{problem.heuristic_value(problem.start())};
+      return estimated_cost >= params.min_estimated_cost
+             && estimated_cost <= params.max_estimated_cost;
+    })};
+
+    if (is_accepted) {
+      return puzzle;
+    }
+  }
+
+  return std::nullopt;
+}
@@ -0,0 +1,355 @@
+#include "../include/hda_star.h"
+#include "../include/ClosedSet.h"
+#include "../include/Grid.h"
+#include "../include/GridDimensions.h"
+#include "../include/MpscQueue.h"
+#include "../include/Node.h"
+#include "../include/NodeStore.h"
+#include "../include/OpenList.h"
+#include "../include/PlacementCache.h"
+#include "../include/Position.h"
+#include "../include/Problem.h"
+#include "../include/Tetromino.h"
+#include "../include/astar.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+/**
+ * A grid state sent by the thread that generated it to the thread that owns it.
+ */
+template <int Width, int Height>
+struct Message {
+  Grid<Width, Height> grid;
+  // Global id of the node it was generated from (see `HdaStar::global_id()`)
+  NodeId parent;
+};
+
+/**
+ * State of an HDA* search, shared by all of its threads (see `hda_star()`).
+ */
+template <int Width, int Height>
+class HdaStar {
+public:
+  HdaStar(const Problem<Width, Height>& problem, const AstarOptions& options);
+
+  /**
+   * Runs the search on `m_workers.size()` threads, then stores its outcome in `result`.
+   */
+  void run(AstarResult& result);
+
+private:
+  using Grid = ::Grid<Width, Height>;
+  using Message = ::Message<Width, Height>;
+
+  /**
+   * State owned by a single thread, other than its inbox.
+   */
+  struct Worker {
+    Worker(const AstarOptions& options, int num_threads)
+        : closed_set{
+              options.closed_set_capacity / num_threads,
+              options.placement_rule == PlacementRule::Chain
+          }
+        , open_list{options.tie_breaking}
+        , outboxes(num_threads) {}
+
+    NodeStore<Width, Height> store{};
+    ClosedSet<Width, Height> closed_set;
+    OpenList open_list;
+    Stats stats{};
+    PlacementCache::Stats placement_cache{};
+
+    // Batches of grid states sent to this thread by other threads
+    MpscQueue<std::vector<Message>> inbox{};
+    // Batches of grid states to be sent by this thread to each other thread
+    std::vector<std::vector<Message>> outboxes{};
+  };
+
+  const Problem<Width, Height>& m_problem;
+  AstarOptions m_options;
+  std::vector<std::unique_ptr<Worker>> m_workers{};
+
+  // Number of busy threads plus the number of batches in flight, which is 0 once the search is
+  // over
+  std::atomic<std::int64_t> m_pending{0};
+
+  // Cost of the cheapest path found so far, or `Problem::UNREACHABLE`
+  std::atomic<int> m_incumbent_cost{Problem<Width, Height>::UNREACHABLE};
+  // Global id of the node at the end of the cheapest path found so far
+  NodeId m_incumbent{NO_NODE};
+  std::mutex m_incumbent_mutex{};
+
+  int num_workers() const;
+
+  /**
+   * Returns the thread that owns grid states with Zobrist hash `hash`.
+   *
+   * Uses the high bits of the hash, since the closed set takes its tags from the low bits (see
+   * `ClosedSet`).
+   */
+  int owner(std::size_t hash) const;
+
+  /**
+   * Returns the id of node `id` of thread `worker`'s store that is unique across all threads.
+   */
+  NodeId global_id(int worker, NodeId id) const;
+  const Node<Width, Height>& node(NodeId global_id) const;
+
+  /**
+   * Adds grid state `message.grid` to thread `worker`'s open list, unless it is a duplicate or
+   * cannot lead to a path cheaper than the incumbent.
+   */
+  void receive(int worker, const Message& message);
+
+  void send(int worker, int to);
+
+  /**
+   * Expands the best node of thread `worker`'s open list.
+   */
+  void expand(int worker);
+
+  void work(int worker);
+};
+
+template <int Width, int Height>
+HdaStar<Width, Height>::HdaStar(
+    const Problem<Width, Height>& problem,
+    const AstarOptions& options
+)
+    : m_problem{problem}
+    , m_options{options} {
+  int num_threads{std::max(options.num_threads, 1)};
+
+  for (int i{0}; i < num_threads; ++i) {
+    m_workers.push_back(std::make_unique<Worker>(options, num_threads));
+  }
+}
+
+template <int Width, int Height>
+void HdaStar<Width, Height>::run(AstarResult& result) {
+  Grid root{m_problem, m_options.placement_rule};
+  auto& root_owner{*m_workers[owner(root.hash())]};
+  auto root_id{root_owner.store.add(root, NO_NODE)};
+  root_owner.open_list.push(root_id, root.g() + root.h(), root.g());
+
+  // Every thread starts busy
+  m_pending = num_workers();
+
+  {
+    std::vector<std::jthread> threads{};
+
+    for (int i{0}; i < num_workers(); ++i) {
+      threads.emplace_back([this, i] {
+        auto cache_stats_before{PlacementCache::local().stats()};
+        work(i);
+        m_workers[i]->placement_cache = PlacementCache::local().stats() - cache_stats_before;
+      });
+    }
+  }
+
+  for (const auto& worker : m_workers) {
+    result.stats.expanded += worker->stats.expanded;
+    result.stats.generated += worker->stats.generated;
+    result.stats.revisited += worker->stats.revisited;
+    result.stats.pruned += worker->stats.pruned;
+    result.placement_cache += worker->placement_cache;
+  }
+
+  if (m_incumbent == NO_NODE) {
+    return;
+  }
+
+  for (auto curr{m_incumbent}; node(curr).parent() != NO_NODE; curr = node(curr).parent()) {
+    const auto& curr_node{node(curr)};
+    result.path.push_back(curr_node.grid().difference(node(curr_node.parent()).grid()));
+  }
+
+  std::ranges::reverse(result.path);
+  result.is_solved = true;
+  result.cost = static_cast<int>(result.path.size());
+}
+
+template <int Width, int Height>
+int HdaStar<Width, Height>::num_workers() const {
+  return static_cast<int>(m_workers.size());
+}
+
+template <int Width, int Height>
+int HdaStar<Width, Height>::owner(std::size_t hash) const {
+  auto high_bits{static_cast<std::uint64_t>(hash) >> 32};
+  return static_cast<int>((high_bits * static_cast<std::uint64_t>(num_workers())) >> 32);
+}
+
+template <int Width, int Height>
+NodeId HdaStar<Width, Height>::global_id(int worker, NodeId id) const {
+  return id * static_cast<NodeId>(num_workers()) + static_cast<NodeId>(worker);
+}
+
+template <int Width, int Height>
+const Node<Width, Height>& HdaStar<Width, Height>::node(NodeId global_id) const {
+  auto n{static_cast<NodeId>(num_workers())};
+  return m_workers[global_id % n]->store[global_id / n];
+}
+
+template <int Width, int Height>
+void HdaStar<Width, Height>::receive(int worker, const Message& message) {
+  auto& self{*m_workers[worker]};
+  const auto& grid{message.grid};
+
+  if (grid.g() + grid.h() >= m_incumbent_cost.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  if (!self.closed_set.insert(grid.placements(), grid.hash(), grid.variant())) {
+    ++self.stats.revisited;
+    return;
+  }
+
+  auto id{self.store.add(grid, message.parent)};
+  self.open_list.push(id, grid.g() + grid.h(), grid.g());
+}
+
+template <int Width, int Height>
+void HdaStar<Width, Height>::send(int worker, int to) {
+  auto& outbox{m_workers[worker]->outboxes[to]};
+
+  // Counted before it is pushed, so that the count cannot reach 0 while it is in flight
+  m_pending.fetch_add(1);
+  m_workers[to]->inbox.push(std::move(outbox));
+  outbox = {};
+}
+
+template <int Width, int Height>
+void HdaStar<Width, Height>::expand(int worker) {
+  auto& self{*m_workers[worker]};
+  auto id{self.open_list.pop()};
+  const auto& best{self.store[id]};
+
+  if (best.grid().g() + best.grid().h() >= m_incumbent_cost.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  // See `astar()`
+  if (m_options.heuristic == Heuristic::FloodFill) {
+    auto grid{best.grid()};
+
+    if (grid.raise_to_flood_fill_heuristic()) {
+      if (grid.is_target_unreachable()) {
+        ++self.stats.pruned;
+      } else {
+        auto raised_id{self.store.add(grid, best.parent())};
+        self.open_list.push(raised_id, grid.g() + grid.h(), grid.g());
+      }
+
+      return;
+    }
+  }
+
+  if (best.grid().is_target_reached()) {
+    std::scoped_lock lock{m_incumbent_mutex};
+
+    if (best.grid().g() < m_incumbent_cost.load()) {
+      m_incumbent_cost = best.grid().g();
+      m_incumbent = global_id(worker, id);
+    }
+
+    return;
+  }
+
+  for (const auto& successor : best.grid().successors()) {
+    ++self.stats.generated;
+
+    Message message{successor, global_id(worker, id)};
+    auto to{owner(successor.hash())};
+
+    if (to == worker) {
+      receive(worker, message);
+    } else {
+      self.outboxes[to].push_back(std::move(message));
+    }
+  }
+
+  ++self.stats.expanded;
+
+  for (int to{0}; to < num_workers(); ++to) {
+    if (!self.outboxes[to].empty()) {
+      send(worker, to);
+    }
+  }
+}
+
+template <int Width, int Height>
+void HdaStar<Width, Height>::work(int worker) {
+  auto& self{*m_workers[worker]};
+  bool is_idle{false};
+
+  while (true) {
+    auto batches{self.inbox.pop_all()};
+
+    if (!batches.empty()) {
+      // Becomes busy before any received batch stops being counted as in flight
+      if (is_idle) {
+        m_pending.fetch_add(1);
+        is_idle = false;
+      }
+
+      batches.for_each([this, worker](const std::vector<Message>& batch) {
+        for (const auto& message : batch) {
+          receive(worker, message);
+        }
+
+        m_pending.fetch_sub(1);
+      });
+    }
+
+    if (!self.open_list.empty()) {
+      expand(worker);
+      continue;
+    }
+
+    if (!is_idle) {
+      m_pending.fetch_sub(1);
+      is_idle = true;
+    }
+
+    // Only busy threads and batches in flight create work, so once neither remain, none ever will
+    if (m_pending.load() == 0) {
+      return;
+    }
+
+    std::this_thread::yield();
+  }
+}
+}
+
+template <int Width, int Height>
+AstarResult hda_star(const Problem<Width, Height>& problem, const AstarOptions& options) {
+  auto start_time{std::chrono::steady_clock::now()};
+  AstarResult result{};
+
+  if (!problem.is_target_enclosed()) {
+    HdaStar<Width, Height>{problem, options}.run(result);
+  }
+
+  auto finish_time{std::chrono::steady_clock::now()};
+  result.elapsed_secs
+      = std::chrono::duration_cast<std::chrono::duration<double>>(finish_time - start_time).count();
+
+  return result;
+}
+
+#define INSTANTIATE_HDA_STAR(width, height)                                                       \
+  template AstarResult hda_star<width, height>(                                                   \
+      const Problem<width, height>& problem, const AstarOptions& options                          \
+  );
+FOR_EACH_GRID_DIMENSIONS(INSTANTIATE_HDA_STAR)
+#undef INSTANTIATE_HDA_STAR
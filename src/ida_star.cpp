@@ -0,0 +1,192 @@
+#include "../include/ida_star.h"
+#include "../include/Grid.h"
+#include "../include/GridDimensions.h"
+#include "../include/Problem.h"
+#include "../include/Tetromino.h"
+#include "../include/astar.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace {
+/**
+ * Represents a fixed-size, direct-mapped table of raised heuristic values, keyed by Zobrist hash.
+ * Newer entries replace older entries that map to the same slot.
+ */
+class TranspositionTable {
+public:
+  /**
+   * Constructs a table of `size` entries, rounded up to a power of 2, or a disabled table if
+   * `size` is 0.
+   */
+  explicit TranspositionTable(std::size_t size)
+      : m_entries(size == 0 ? 0 : std::bit_ceil(size)) {}
+
+  /**
+   * Returns the heuristic value stored for Zobrist hash `hash`, or 0 if there is none.
+   */
+  int lookup(std::size_t hash) const {
+    if (m_entries.empty()) {
+      return 0;
+    }
+
+    const auto& entry{m_entries[hash & (m_entries.size() - 1)]};
+    return entry.hash == hash ? entry.h : 0;
+  }
+
+  void store(std::size_t hash, int h) {
+    if (!m_entries.empty()) {
+      m_entries[hash & (m_entries.size() - 1)] = {hash, h};
+    }
+  }
+
+private:
+  struct Entry {
+    std::size_t hash{0};
+    int h{0};
+  };
+
+  std::vector<Entry> m_entries;
+};
+
+template <int Width, int Height>
+class IdaStar {
+public:
+  IdaStar(const Problem<Width, Height>& problem, const AstarOptions& options);
+
+  void run(AstarResult& result);
+
+private:
+  using Grid = ::Grid<Width, Height>;
+
+  // Returned by `search()` once a path to the target position has been found
+  static constexpr int FOUND{-1};
+
+  AstarOptions m_options;
+  TranspositionTable m_transposition_table;
+  Stats m_stats{};
+
+  // Grids along the current path, from the root grid
+  std::vector<Grid> m_path{};
+
+  /**
+   * Searches depth-first from the last grid of `m_path`, abandoning any path whose f exceeds
+   * `threshold`. Returns `FOUND` if a path to the target position is found (leaving it in
+   * `m_path`), otherwise the lowest f that exceeded `threshold`, or `Problem::UNREACHABLE` if
+   * there is none.
+   */
+  int search(int threshold);
+};
+
+template <int Width, int Height>
+IdaStar<Width, Height>::IdaStar(const Problem<Width, Height>& problem, const AstarOptions& options)
+    : m_options{options}
+    , m_transposition_table{options.transposition_table_size} {
+  m_path.emplace_back(problem, options.placement_rule);
+}
+
+template <int Width, int Height>
+void IdaStar<Width, Height>::run(AstarResult& result) {
+  auto threshold{m_path.front().h()};
+
+  while (threshold != Problem<Width, Height>::UNREACHABLE) {
+    threshold = search(threshold);
+
+    if (threshold == FOUND) {
+      for (std::size_t i{1}; i < m_path.size(); ++i) {
+        result.path.push_back(m_path[i].difference(m_path[i - 1]));
+      }
+
+      result.is_solved = true;
+      result.cost = static_cast<int>(result.path.size());
+      break;
+    }
+  }
+
+  result.stats = m_stats;
+}
+
+template <int Width, int Height>
+int IdaStar<Width, Height>::search(int threshold) {
+  auto& grid{m_path.back()};
+
+  if (m_options.heuristic == Heuristic::FloodFill) {
+    grid.raise_to_flood_fill_heuristic();
+
+    if (grid.is_target_unreachable()) {
+      ++m_stats.pruned;
+      return Problem<Width, Height>::UNREACHABLE;
+    }
+  }
+
+  auto h{grid.h()};
+  auto stored_h{m_transposition_table.lookup(grid.hash())};
+
+  if (stored_h > h) {
+    h = stored_h;
+  }
+
+  if (grid.g() + h > threshold) {
+    m_stats.revisited += (grid.g() + grid.h() <= threshold);
+    return grid.g() + h;
+  }
+
+  if (grid.is_target_reached()) {
+    return FOUND;
+  }
+
+  // Only moves are held for each grid on the path, and successor grids are constructed one at a
+  // time, since successor grids are far larger
+  auto moves{grid.moves()};
+  m_stats.generated += static_cast<int>(moves.size());
+  ++m_stats.expanded;
+
+  std::ranges::stable_sort(moves, {}, [&grid](Move move) { return grid.successor_h(move); });
+
+  int min_exceeded{Problem<Width, Height>::UNREACHABLE};
+
+  for (auto move : moves) {
+    m_path.push_back(m_path.back().successor(move));
+    auto result{search(threshold)};
+
+    if (result == FOUND) {
+      return FOUND;
+    }
+
+    m_path.pop_back();
+    min_exceeded = std::min(result, min_exceeded);
+  }
+
+  // The subtree exceeded the threshold, so its lowest exceeding f bounds the cost from this grid
+  if (min_exceeded != Problem<Width, Height>::UNREACHABLE) {
+    m_transposition_table.store(m_path.back().hash(), min_exceeded - m_path.back().g());
+  }
+
+  return min_exceeded;
+}
+}
+
+template <int Width, int Height>
+AstarResult ida_star(const Problem<Width, Height>& problem, const AstarOptions& options) {
+  auto start_time{std::chrono::steady_clock::now()};
+  AstarResult result{};
+
+  if (!problem.is_target_enclosed()) {
+    IdaStar<Width, Height>{problem, options}.run(result);
+  }
+
+  auto finish_time{std::chrono::steady_clock::now()};
+  result.elapsed_secs
+      = std::chrono::duration_cast<std::chrono::duration<double>>(finish_time - start_time).count();
+
+  return result;
+}
+
+#define INSTANTIATE_IDA_STAR(width, height)                                                       \
+  template AstarResult ida_star<width, height>(                                                   \
+      const Problem<width, height>& problem, const AstarOptions& options                          \
+  );
+FOR_EACH_GRID_DIMENSIONS(INSTANTIATE_IDA_STAR)
+#undef INSTANTIATE_IDA_STAR
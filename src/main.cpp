@@ -1,21 +1,446 @@
 #include "../include/astar.h"
+#include "../include/batch.h"
+#include "../include/generator.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace {
+void print_usage() {
+  std::cout << "Usage:\n";
+  std::cout << "  tetromino_astar [<search options>] <input_file.txt>\n";
+  std::cout << "  tetromino_astar --batch [--threads <n>] [--manifest <manifest_file>] "
+               "[<search options>] [<input_file.txt | directory>...]\n";
+  std::cout << "  tetromino_astar --generate [<generator options>] <output_directory>\n";
+  std::cout << "Search options:\n";
+  std::cout << "  --algorithm <astar | hda-star | ida-star | frontier | bidirectional | ara-star | "
+               "beam | pea-star | external | sma-star>\n";
+  std::cout << "  --search-threads <n>\n";
+  std::cout << "  --heuristic <static | flood-fill>\n";
+  std::cout << "  --placement <anywhere | chain>\n";
+  std::cout << "  --tie-breaking <lifo | fifo | deepest | shallowest>\n";
+  std::cout << "  --closed-set-capacity <n>\n";
+  std::cout << "  --bitstate <megabytes>\n";
+  std::cout << "  --bitstate-hashes <k>\n";
+  std::cout << "  --transposition-table-size <n>\n";
+  std::cout << "  --weight <w>\n";
+  std::cout << "  --weight-step <d>\n";
+  std::cout << "  --time-limit <seconds>\n";
+  std::cout << "  --beam-width <n>\n";
+  std::cout << "  --memory-limit <megabytes>\n";
+  std::cout << "  --spill-dir <directory>\n";
+  std::cout << "Generator options:\n";
+  std::cout << "  --count <n>\n";
+  std::cout << "  --seed <s>\n";
+  std::cout << "  --width <w>\n";
+  std::cout << "  --height <h>\n";
+  std::cout << "  --density <d>\n";
+  std::cout << "  --min-distance <cells>\n";
+  std::cout << "  --min-cost <n>\n";
+  std::cout << "  --max-cost <n>\n";
+}
+
+/**
+ * Parses the search option at `argv[i]` (and its value) into `options`, advancing `i` past its
+ * value. Returns `true` if successful, otherwise `false`.
+ */
+bool parse_search_option(int argc, char* argv[], int& i, AstarOptions& options) {
+  std::string_view arg{argv[i]};
+
+  if (i + 1 >= argc) {
+    return false;
+  }
+
+  if (arg == "--algorithm") {
+    std::string_view value{argv[++i]};
+
+    if (value == "astar") {
+      options.algorithm = Algorithm::Astar;
+    } else if (value == "hda-star") {
+      options.algorithm = Algorithm::HdaStar;
+    } else if (value == "ida-star") {
+      options.algorithm = Algorithm::IdaStar;
+    } else if (value == "frontier") {
+      options.algorithm = Algorithm::FrontierSearch;
+    } else if (value == "bidirectional") {
+      options.algorithm = Algorithm::Bidirectional;
+    } else if (value == "ara-star") {
+      options.algorithm = Algorithm::AraStar;
+    } else if (value == "beam") {
+      options.algorithm = Algorithm::BeamSearch;
+    } else if (value == "pea-star") {
+      options.algorithm = Algorithm::PeaStar;
+    } else if (value == "external") {
+      options.algorithm = Algorithm::ExternalAstar;
+    } else if (value == "sma-star") {
+      options.algorithm = Algorithm::SmaStar;
+    } else {
+      return false;
+    }
+
+    return true;
+  }
+
+  if (arg == "--search-threads") {
+    options.num_threads = std::atoi(argv[++i]);
+    return options.num_threads > 0;
+  }
+
+  if (arg == "--heuristic") {
+    std::string_view value{argv[++i]};
+
+    if (value == "static") {
+      options.heuristic = Heuristic::Static;
+    } else if (value == "flood-fill") {
+      options.heuristic = Heuristic::FloodFill;
+    } else {
+      return false;
+    }
+
+    return true;
+  }
+
+  if (arg == "--placement") {
+    std::string_view value{argv[++i]};
+
+    if (value == "anywhere") {
+      options.placement_rule = PlacementRule::Anywhere;
+    } else if (value == "chain") {
+      options.placement_rule = PlacementRule::Chain;
+    } else {
+      return false;
+    }
+
+    return true;
+  }
+
+  if (arg == "--tie-breaking") {
+    std::string_view value{argv[++i]};
+
+    if (value == "lifo") {
+      options.tie_breaking = TieBreaking::Lifo;
+    } else if (value == "fifo") {
+      options.tie_breaking = TieBreaking::Fifo;
+    } else if (value == "deepest") {
+      options.tie_breaking = TieBreaking::DeepestFirst;
+    } else if (value == "shallowest") {
+      options.tie_breaking = TieBreaking::ShallowestFirst;
+    } else {
+      return false;
+    }
+
+    return true;
+  }
+
+  if (arg == "--closed-set-capacity") {
+    auto capacity{std::atoll(argv[++i])};
+
+    if (capacity <= 0) {
+      return false;
+    }
+
+    options.closed_set_capacity = static_cast<std::size_t>(capacity);
+    return true;
+  }
+
+  if (arg == "--bitstate") {
+    auto megabytes{std::atoll(argv[++i])};
+
+    if (megabytes <= 0) {
+      return false;
+    }
+
+    options.bitstate_bits = static_cast<std::size_t>(megabytes) << 23;
+    return true;
+  }
+
+  if (arg == "--bitstate-hashes") {
+    options.bitstate_hashes = std::atoi(argv[++i]);
+    return options.bitstate_hashes > 0;
+  }
+
+  if (arg == "--transposition-table-size") {
+    auto size{std::atoll(argv[++i])};
+
+    if (size < 0) {
+      return false;
+    }
+
+    options.transposition_table_size = static_cast<std::size_t>(size);
+    return true;
+  }
+
+  if (arg == "--weight") {
+    options.weight = std::atof(argv[++i]);
+    return options.weight >= 1.0;
+  }
+
+  if (arg == "--weight-step") {
+    options.weight_step = std::atof(argv[++i]);
+    return options.weight_step > 0.0;
+  }
+
+  if (arg == "--time-limit") {
+    options.time_limit_secs = std::atof(argv[++i]);
+    return options.time_limit_secs > 0.0;
+  }
+
+  if (arg == "--beam-width") {
+    auto width{std::atoll(argv[++i])};
+
+    if (width <= 0) {
+      return false;
+    }
+
+    options.beam_width = static_cast<std::size_t>(width);
+    return true;
+  }
+
+  if (arg == "--memory-limit") {
+    auto megabytes{std::atoll(argv[++i])};
+
+    if (megabytes <= 0) {
+      return false;
+    }
+
+    options.memory_limit_bytes = static_cast<std::size_t>(megabytes) << 20;
+    return true;
+  }
+
+  if (arg == "--spill-dir") {
+    options.spill_dir = argv[++i];
+    return true;
+  }
+
+  return false;
+}
+
+/**
+ * Returns `true` if the search options in `options` can be used together, otherwise writes an error
+ * message and returns `false`.
+ */
+bool check_search_options(const AstarOptions& options) {
+  // The backward search and the join of a forward grid with a backward grid assume that tetrominoes
+  // may be placed anywhere
+  if (options.algorithm == Algorithm::Bidirectional
+      && options.placement_rule == PlacementRule::Chain) {
+    std::cout << "Error: --placement chain is not supported by --algorithm bidirectional.\n";
+    return false;
+  }
+
+  // A parent whose child does not fit is put back with the same f, so unless it is ordered after
+  // its children, it would be expanded again and again
+  if (options.algorithm == Algorithm::SmaStar
+      && options.tie_breaking != TieBreaking::DeepestFirst) {
+    std::cout << "Error: --algorithm sma-star only supports --tie-breaking deepest.\n";
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Solves many input files without visualisation, writing one JSON result line per input file (see
+ * `solve_batch()`).
+ */
+int run_batch(int argc, char* argv[]) {
+  int num_threads{static_cast<int>(std::thread::hardware_concurrency())};
+  AstarOptions options{};
+  std::vector<std::string> paths{};
+
+  for (int i{2}; i < argc; ++i) {
+    std::string_view arg{argv[i]};
+
+    if (arg == "--threads" && i + 1 < argc) {
+      num_threads = std::atoi(argv[++i]);
+
+      if (num_threads <= 0) {
+        std::cout << "Error: The number of threads must be positive.\n";
+        return EXIT_FAILURE;
+      }
+    } else if (arg == "--manifest" && i + 1 < argc) {
+      if (!read_manifest(argv[++i], paths)) {
+        std::cout << "Error: Unable to read manifest file " << argv[i] << ".\n";
+        return EXIT_FAILURE;
+      }
+    } else if (arg.starts_with("--")) {
+      if (!parse_search_option(argc, argv, i, options)) {
+        print_usage();
+        return EXIT_FAILURE;
+      }
+    } else {
+      paths.emplace_back(arg);
+    }
+  }
+
+  if (!check_search_options(options)) {
+    return EXIT_FAILURE;
+  }
+
+  auto filenames{collect_puzzle_files(paths)};
+
+  if (filenames.empty()) {
+    std::cout << "Error: Missing input files.\n";
+    return EXIT_FAILURE;
+  }
+
+  solve_batch(filenames, num_threads, options, std::cout);
+
+  return EXIT_SUCCESS;
+}
+
+/**
+ * Writes input files of random puzzles to a directory (see `generate_puzzle()`), named by seed and
+ * index so that they are listed in order of index.
+ */
+int run_generate(int argc, char* argv[]) {
+  GeneratorParams params{};
+  long long count{1};
+  const char* directory{nullptr};
+
+  for (int i{2}; i < argc; ++i) {
+    std::string_view arg{argv[i]};
+
+    if (!arg.starts_with("--")) {
+      directory = argv[i];
+    } else if (i + 1 >= argc) {
+      print_usage();
+      return EXIT_FAILURE;
+    } else if (arg == "--count") {
+      count = std::atoll(argv[++i]);
+    } else if (arg == "--seed") {
+      params.seed = std::strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--width") {
+      params.width = std::atoi(argv[++i]);
+    } else if (arg == "--height") {
+      params.height = std::atoi(argv[++i]);
+    } else if (arg == "--density") {
+      params.obstacle_density = std::atof(argv[++i]);
+    } else if (arg == "--min-distance") {
+      params.min_distance = std::atoi(argv[++i]);
+    } else if (arg == "--min-cost") {
+      params.min_estimated_cost = std::atoi(argv[++i]);
+    } else if (arg == "--max-cost") {
+      params.max_estimated_cost = std::atoi(argv[++i]);
+    } else {
+      print_usage();
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (directory == nullptr) {
+    std::cout << "Error: Missing output directory.\n";
+    return EXIT_FAILURE;
+  }
+
+  if (count <= 0) {
+    std::cout << "Error: The number of puzzles must be positive.\n";
+    return EXIT_FAILURE;
+  }
+
+  if (params.width < 1 || params.width > MAX_GRID_WIDTH || params.height < 1
+      || params.height > MAX_GRID_HEIGHT || params.width * params.height < 2) {
+    std::cout << "Error: The board must have at least 2 positions and fit within "
+              << MAX_GRID_WIDTH << "x" << MAX_GRID_HEIGHT << ".\n";
+    return EXIT_FAILURE;
+  }
+
+  if (!(params.obstacle_density >= 0.0 && params.obstacle_density < 1.0)) {
+    std::cout << "Error: The obstacle density must be in [0, 1).\n";
+    return EXIT_FAILURE;
+  }
+
+  if (params.min_estimated_cost > params.max_estimated_cost) {
+    std::cout << "Error: The minimum cost must not exceed the maximum cost.\n";
+    return EXIT_FAILURE;
+  }
+
+  std::error_code error{};
+  std::filesystem::create_directories(directory, error);
+
+  if (error) {
+    std::cout << "Error: Unable to create directory " << directory << ".\n";
+    return EXIT_FAILURE;
+  }
+
+  long long num_written{0};
+
+  for (long long index{0}; index < count; ++index) {
+    auto puzzle{generate_puzzle(params, static_cast<std::uint64_t>(index))};
+
+    if (!puzzle) {
+      std::cout << "Error: No puzzle " << index << " was found in " << MAX_GENERATOR_ATTEMPTS
+                << " attempts. Try a lower density, distance, or cost.\n";
+      continue;
+    }
+
+    std::ostringstream name{};
+    name << params.seed << "_" << std::setw(6) << std::setfill('0') << index << ".txt";
+    auto filename{(std::filesystem::path{directory} / name.str()).string()};
+
+    if (!write_astar_params(filename, *puzzle)) {
+      std::cout << "Error: Unable to write file " << filename << ".\n";
+      return EXIT_FAILURE;
+    }
+
+    ++num_written;
+  }
+
+  std::cout << num_written << " of " << count << " puzzles were written to " << directory << ".\n";
+
+  return num_written == count ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+}
 
 int main(int argc, char* argv[]) {
-  if (argc < 2) {
+  if (argc >= 2 && std::string_view{argv[1]} == "--batch") {
+    return run_batch(argc, argv);
+  }
+
+  if (argc >= 2 && std::string_view{argv[1]} == "--generate") {
+    return run_generate(argc, argv);
+  }
+
+  AstarOptions options{.visualise = true};
+  const char* filename{nullptr};
+
+  for (int i{1}; i < argc; ++i) {
+    if (!std::string_view{argv[i]}.starts_with("--")) {
+      filename = argv[i];
+    } else if (!parse_search_option(argc, argv, i, options)) {
+      print_usage();
+      return 0;
+    }
+  }
+
+  if (!check_search_options(options)) {
+    return 0;
+  }
+
+  if (filename == nullptr) {
     std::cout << "Error: Missing input file.\n";
+    print_usage();
     return 0;
   }
 
   AstarParams params{};
 
-  if (!read_astar_params(argv[1], params)) {
+  if (!read_astar_params(filename, params)) {
     std::cout
         << "Error: Input file does not follow the expected format as described in README.md.\n";
     return 0;
   }
 
-  astar(params.start, params.target, params.obstacles, true);
+  astar_interactive(params, options);
 
   return 0;
 }
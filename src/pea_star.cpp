@@ -0,0 +1,168 @@
+#include "../include/pea_star.h"
+#include "../include/ClosedSet.h"
+#include "../include/Grid.h"
+#include "../include/GridDimensions.h"
+#include "../include/Node.h"
+#include "../include/NodeStore.h"
+#include "../include/OpenList.h"
+#include "../include/Problem.h"
+#include "../include/astar.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+template <int Width, int Height>
+class PeaStar {
+public:
+  PeaStar(const Problem<Width, Height>& problem, const AstarOptions& options);
+
+  void run(AstarResult& result);
+
+private:
+  using Grid = ::Grid<Width, Height>;
+
+  const Problem<Width, Height>& m_problem;
+  AstarOptions m_options;
+  Stats m_stats{};
+
+  NodeStore<Width, Height> m_store{};
+  ClosedSet<Width, Height> m_closed_set;
+  OpenList m_open_list;
+
+  /**
+   * Constructs the successors of node `id` whose f is `stored_f` (or at most `stored_f`, if
+   * `is_first` is `true`), then puts the node back in the open list with the lowest f of any
+   * successor above `stored_f`, if there is one.
+   */
+  void expand(NodeId id, int stored_f, bool is_first);
+
+  /**
+   * Adds a node encapsulating `grid`, whose parent is node `parent`, to the open list, with its
+   * own f as its stored f.
+   */
+  void push(const Grid& grid, NodeId parent);
+
+  int f(const Grid& grid) const;
+};
+
+template <int Width, int Height>
+PeaStar<Width, Height>::PeaStar(const Problem<Width, Height>& problem, const AstarOptions& options)
+    : m_problem{problem}
+    , m_options{options}
+    , m_closed_set{options.closed_set_capacity, options.placement_rule == PlacementRule::Chain}
+    , m_open_list{options.tie_breaking} {}
+
+template <int Width, int Height>
+void PeaStar<Width, Height>::run(AstarResult& result) {
+  Grid root{m_problem, m_options.placement_rule};
+
+  m_closed_set.insert(root.placements(), root.hash(), root.variant());
+  push(root, NO_NODE);
+
+  while (!m_open_list.empty()) {
+    auto stored_f{m_open_list.min_f()};
+    auto id{m_open_list.pop()};
+
+    // Nodes are never moved by the store, so this remains valid as successors are added
+    const auto& node{m_store[id]};
+
+    // A node put back after a partial expansion has a stored f above its own f
+    auto is_first{stored_f == f(node.grid())};
+
+    // As in `astar()`, the flood-fill heuristic is only calculated for nodes about to be expanded
+    if (is_first && m_options.heuristic == Heuristic::FloodFill) {
+      auto grid{node.grid()};
+
+      if (grid.raise_to_flood_fill_heuristic()) {
+        if (grid.is_target_unreachable()) {
+          ++m_stats.pruned;
+        } else {
+          push(grid, node.parent());
+        }
+
+        continue;
+      }
+    }
+
+    if (node.grid().is_target_reached()) {
+      result.is_solved = true;
+      result.path = m_store.path(id);
+      result.cost = static_cast<int>(result.path.size());
+      result.suboptimality_bound = m_options.weight;
+      break;
+    }
+
+    expand(id, stored_f, is_first);
+  }
+
+  result.stats = m_stats;
+}
+
+template <int Width, int Height>
+void PeaStar<Width, Height>::expand(NodeId id, int stored_f, bool is_first) {
+  const auto& grid{m_store[id].grid()};
+  auto next_f{Problem<Width, Height>::UNREACHABLE};
+
+  for (auto move : grid.moves()) {
+    auto successor_f{weighted_f(grid.g() + 1, grid.successor_h(move), m_options.weight)};
+
+    if (successor_f > stored_f) {
+      next_f = std::min(successor_f, next_f);
+      continue;
+    }
+
+    // Constructed by an earlier partial expansion of the node
+    if (successor_f < stored_f && !is_first) {
+      continue;
+    }
+
+    auto successor{grid.successor(move)};
+    ++m_stats.generated;
+
+    if (m_closed_set.insert(successor.placements(), successor.hash(), successor.variant())) {
+      push(successor, id);
+    } else {
+      ++m_stats.revisited;
+    }
+  }
+
+  ++m_stats.expanded;
+
+  if (next_f != Problem<Width, Height>::UNREACHABLE) {
+    m_open_list.push(id, next_f, grid.g());
+  }
+}
+
+template <int Width, int Height>
+void PeaStar<Width, Height>::push(const Grid& grid, NodeId parent) {
+  m_open_list.push(m_store.add(grid, parent), f(grid), grid.g());
+}
+
+template <int Width, int Height>
+int PeaStar<Width, Height>::f(const Grid& grid) const {
+  return weighted_f(grid.g(), grid.h(), m_options.weight);
+}
+}
+
+template <int Width, int Height>
+AstarResult pea_star(const Problem<Width, Height>& problem, const AstarOptions& options) {
+  auto start_time{std::chrono::steady_clock::now()};
+  AstarResult result{};
+
+  if (!problem.is_target_enclosed()) {
+    PeaStar<Width, Height>{problem, options}.run(result);
+  }
+
+  auto finish_time{std::chrono::steady_clock::now()};
+  result.elapsed_secs
+      = std::chrono::duration_cast<std::chrono::duration<double>>(finish_time - start_time).count();
+
+  return result;
+}
+
+#define INSTANTIATE_PEA_STAR(width, height)                                                       \
+  template AstarResult pea_star<width, height>(                                                   \
+      const Problem<width, height>& problem, const AstarOptions& options                          \
+  );
+FOR_EACH_GRID_DIMENSIONS(INSTANTIATE_PEA_STAR)
+#undef INSTANTIATE_PEA_STAR
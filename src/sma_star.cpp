@@ -0,0 +1,563 @@
+#include "../include/sma_star.h"
+#include "../include/ClosedSet.h"
+#include "../include/FlatBitGrid.h"
+#include "../include/Grid.h"
+#include "../include/GridDimensions.h"
+#include "../include/Node.h"
+#include "../include/Position.h"
+#include "../include/Problem.h"
+#include "../include/Tetromino.h"
+#include "../include/astar.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace {
+/**
+ * A node of SMA*, which holds the move that leads to its grid from its parent's grid rather than
+ * the grid itself (as with `CompactNode`).
+ */
+struct SmaNode {
+  // Id of the parent, or `NO_NODE` for the root node. Once the node is forgotten, the id of the
+  // node forgotten before it that has not been reused, or `NO_NODE` if none
+  NodeId parent;
+  // f as ordered by the open list, which is at least the f of the parent when it was expanded, and
+  // for a node put back in the open list, the lowest f of any forgotten child
+  int f;
+  // Lowest f of any child forgotten since the node was last expanded, or `UNREACHABLE` if none
+  int forgotten_f;
+  // Number of children in memory
+  std::uint32_t num_children;
+  std::int16_t g;
+  std::uint8_t anchor_x;
+  std::uint8_t anchor_y;
+  std::uint8_t tetromino;
+  bool is_open;
+
+  Move move() const {
+    return {tetromino, {anchor_x, anchor_y}};
+  }
+};
+
+static_assert(MAX_GRID_WIDTH <= 256 && MAX_GRID_HEIGHT <= 256);
+static_assert(NUM_FIXED_TETROMINOES <= 256);
+static_assert(sizeof(SmaNode) == 24);
+
+/**
+ * A node in the open list, which is ordered by f (lowest first), then g (highest first), then id
+ * (highest first, which is usually the most recently added).
+ */
+struct OpenEntry {
+  int f;
+  int g;
+  NodeId id;
+
+  bool operator<(const OpenEntry& other) const {
+    return std::tie(f, other.g, other.id) < std::tie(other.f, g, id);
+  }
+};
+
+// Bytes held by each entry of a `std::set<OpenEntry>`, including the links and colour of its tree
+// node
+constexpr std::size_t OPEN_ENTRY_BYTES{sizeof(OpenEntry) + 4 * sizeof(void*)};
+
+template <int Width, int Height>
+class SmaStar {
+public:
+  SmaStar(const Problem<Width, Height>& problem, const AstarOptions& options);
+
+  void run(AstarResult& result);
+
+private:
+  using Grid = ::Grid<Width, Height>;
+
+  // Number of nodes per chunk is a power of 2, so that ids split into chunk and offset by shifting
+  static constexpr int CHUNK_SHIFT{12};
+  static constexpr std::size_t CHUNK_SIZE{std::size_t{1} << CHUNK_SHIFT};
+  // Number of nodes the first chunk holds at first
+  static constexpr std::size_t MIN_CHUNK_SIZE{16};
+  // Fewest bytes held by each node in memory, with its entries in the open list and closed set
+  static constexpr std::size_t MIN_NODE_BYTES{
+      sizeof(SmaNode) + OPEN_ENTRY_BYTES + sizeof(FlatBitGrid<Width, Height>)
+  };
+
+  const Problem<Width, Height>& m_problem;
+  AstarOptions m_options;
+  Stats m_stats{};
+  Grid m_root;
+
+  // Nodes, `CHUNK_SIZE` per chunk, where the first chunk starts small and doubles as it fills
+  std::vector<std::vector<SmaNode>> m_node_chunks{};
+  // Number of nodes allocated, including forgotten nodes
+  std::size_t m_num_nodes{0};
+  // Most recently forgotten node that has not been reused, or `NO_NODE` if none
+  NodeId m_forgotten_id{NO_NODE};
+  ClosedSet<Width, Height> m_closed_set;
+  std::set<OpenEntry> m_open_list{};
+
+  // Node being expanded, which is never forgotten meanwhile
+  NodeId m_expanding_id{NO_NODE};
+  // Most recently expanded node and its grid, which the grids of its children are rebuilt from
+  // in 1 move rather than from the root grid
+  NodeId m_last_id{NO_NODE};
+  Grid m_last_grid;
+
+  MemoryUsage m_peak_memory{};
+  // Total bytes last reported to `m_options.on_memory_usage`
+  std::size_t m_reported_bytes{0};
+
+  SmaNode& node(NodeId id);
+  const SmaNode& node(NodeId id) const;
+
+  /**
+   * Adds a node encapsulating `grid` with f `f`, whose parent is node `parent` and which `move`
+   * leads to, to the closed set and open list. Returns `false` if `grid` was already in the closed
+   * set.
+   */
+  bool add(NodeId parent, Move move, const Grid& grid, int f);
+
+  /**
+   * Generates the successors of node `id`, whose grid is `grid`, that are not in memory. Returns
+   * `false` if the memory limit cannot hold them.
+   */
+  bool expand(NodeId id, const Grid& grid);
+
+  /**
+   * Forgets leaves until a node with f `f` and actual cost `g` can be added within the memory
+   * limit, as long as each leaf is worse (i.e., ordered after it in the open list). Returns `false`
+   * if it cannot be added.
+   */
+  bool reserve(int f, int g);
+
+  /**
+   * Returns the leaf with the highest f, then the lowest g, in the open list, other than the root
+   * node and the node being expanded, or `NO_NODE` if there is none.
+   */
+  NodeId worst_leaf() const;
+
+  /**
+   * Removes node `id` from memory, and backs its f up into its parent, unless `is_dead_end` is
+   * `true` (i.e., nothing is left to search below it).
+   */
+  void forget(NodeId id, bool is_dead_end);
+
+  /**
+   * Puts node `id` back in the open list with the lowest f of its forgotten children, after a child
+   * with f `f` was forgotten or could not be added.
+   */
+  void back_up(NodeId id, int f);
+
+  void open(NodeId id);
+  void close(NodeId id);
+
+  /**
+   * Returns the bytes held by nodes, the open list, and the closed set.
+   */
+  MemoryUsage memory_usage() const;
+
+  /**
+   * Records the bytes held if they are the most so far, and reports them to
+   * `m_options.on_memory_usage` if their total has changed enough since the last report.
+   */
+  void account_memory_usage();
+
+  /**
+   * Returns the number of bytes that adding a node would allocate.
+   */
+  std::size_t insertion_bytes() const;
+
+  /**
+   * Returns the number of nodes that the last chunk must grow to hold, or a new chunk must hold, to
+   * fit 1 more node, or 0 if the last chunk has room for it.
+   */
+  std::size_t grown_chunk_size() const;
+
+  /**
+   * Returns the grid of node `id`, rebuilt from the root grid.
+   */
+  Grid grid(NodeId id) const;
+
+  /**
+   * Returns the moves that lead from the root grid to the grid of node `id`, in order.
+   */
+  std::vector<Move> moves(NodeId id) const;
+};
+
+template <int Width, int Height>
+SmaStar<Width, Height>::SmaStar(const Problem<Width, Height>& problem, const AstarOptions& options)
+    : m_problem{problem}
+    , m_options{options}
+    , m_root{problem, options.placement_rule}
+    // The initial table holds no more grids than the limit could, so that it fits well within it
+    , m_closed_set{
+          std::min(options.closed_set_capacity, options.memory_limit_bytes / MIN_NODE_BYTES),
+          options.placement_rule == PlacementRule::Chain
+      }
+    , m_last_grid{m_root} {
+  // Chunks are never added beyond the limit, so their list never grows
+  m_node_chunks.reserve(options.memory_limit_bytes / (CHUNK_SIZE * sizeof(SmaNode)) + 1);
+}
+
+template <int Width, int Height>
+void SmaStar<Width, Height>::run(AstarResult& result) {
+  auto root_f{m_root.g() + m_root.h()};
+
+  if (!reserve(root_f, m_root.g()) || !add(NO_NODE, {}, m_root, root_f)) {
+    result.is_incomplete = true;
+  }
+
+  while (!result.is_incomplete && !m_open_list.empty()) {
+    // Nodes may have been forgotten since the last node was added
+    account_memory_usage();
+
+    auto id{m_open_list.begin()->id};
+    close(id);
+
+    auto grid{m_last_id != NO_NODE && node(id).parent == m_last_id
+                  ? m_last_grid.successor(node(id).move())
+                  : this->grid(id)};
+
+    // As with A*, the flood-fill heuristic is only calculated for nodes about to be expanded, and a
+    // node whose f rises is put back in the open list instead, unless it is a dead end
+    if (m_options.heuristic == Heuristic::FloodFill && grid.raise_to_flood_fill_heuristic()) {
+      if (grid.is_target_unreachable()) {
+        ++m_stats.pruned;
+        forget(id, true);
+        continue;
+      }
+
+      if (auto raised_f{grid.g() + grid.h()}; raised_f > node(id).f) {
+        node(id).f = raised_f;
+        open(id);
+        continue;
+      }
+    }
+
+    if (grid.is_target_reached()) {
+      result.is_solved = true;
+
+      for (auto move : moves(id)) {
+        auto& positions{result.path.emplace_back()};
+        std::ranges::transform(
+            FIXED_TETROMINOES[move.tetromino].pieces, positions.begin(), [move](Position piece) {
+              return Position{move.anchor.x + piece.x, move.anchor.y + piece.y};
+            }
+        );
+      }
+
+      result.cost = static_cast<int>(result.path.size());
+      break;
+    }
+
+    m_last_id = id;
+    m_last_grid = std::move(grid);
+
+    if (!expand(id, m_last_grid)) {
+      result.is_incomplete = true;
+      break;
+    }
+  }
+
+  result.stats = m_stats;
+  result.peak_memory = m_peak_memory;
+}
+
+template <int Width, int Height>
+SmaNode& SmaStar<Width, Height>::node(NodeId id) {
+  return m_node_chunks[id >> CHUNK_SHIFT][id & (CHUNK_SIZE - 1)];
+}
+
+template <int Width, int Height>
+const SmaNode& SmaStar<Width, Height>::node(NodeId id) const {
+  return m_node_chunks[id >> CHUNK_SHIFT][id & (CHUNK_SIZE - 1)];
+}
+
+template <int Width, int Height>
+bool SmaStar<Width, Height>::add(NodeId parent, Move move, const Grid& grid, int f) {
+  if (!m_closed_set.insert(grid.placements(), grid.hash(), grid.variant())) {
+    return false;
+  }
+
+  SmaNode added{
+      parent,
+      f,
+      Problem<Width, Height>::UNREACHABLE,
+      0,
+      static_cast<std::int16_t>(grid.g()),
+      static_cast<std::uint8_t>(move.anchor.x),
+      static_cast<std::uint8_t>(move.anchor.y),
+      static_cast<std::uint8_t>(move.tetromino),
+      false
+  };
+  NodeId id{};
+
+  if (m_forgotten_id != NO_NODE) {
+    id = m_forgotten_id;
+    m_forgotten_id = node(id).parent;
+    node(id) = added;
+  } else {
+    if (auto chunk_size{grown_chunk_size()}; chunk_size != 0) {
+      if (m_num_nodes % CHUNK_SIZE == 0) {
+        m_node_chunks.emplace_back();
+      }
+
+      m_node_chunks.back().reserve(chunk_size);
+    }
+
+    id = static_cast<NodeId>(m_num_nodes++);
+    m_node_chunks.back().push_back(added);
+  }
+
+  if (parent != NO_NODE) {
+    ++node(parent).num_children;
+  }
+
+  open(id);
+  account_memory_usage();
+
+  return true;
+}
+
+template <int Width, int Height>
+bool SmaStar<Width, Height>::expand(NodeId id, const Grid& grid) {
+  auto stored_f{node(id).f};
+  node(id).forgotten_f = Problem<Width, Height>::UNREACHABLE;
+  m_expanding_id = id;
+
+  for (auto move : grid.moves()) {
+    ++m_stats.generated;
+
+    // A regenerated child is known to cost at least as much as its parent's backed-up f
+    auto successor{grid.successor(move)};
+    auto f{std::max(successor.g() + successor.h(), stored_f)};
+
+    // A child that does not fit is forgotten straight away, unless nothing else can be, in which
+    // case the limit cannot hold the current path and 1 more node
+    if (!reserve(f, successor.g())) {
+      if (worst_leaf() == NO_NODE) {
+        m_expanding_id = NO_NODE;
+        return false;
+      }
+
+      back_up(id, f);
+    } else if (!add(id, move, successor, f)) {
+      ++m_stats.revisited;
+    }
+  }
+
+  ++m_stats.expanded;
+  m_expanding_id = NO_NODE;
+
+  if (node(id).num_children == 0 && !node(id).is_open) {
+    forget(id, true);
+  }
+
+  return true;
+}
+
+template <int Width, int Height>
+bool SmaStar<Width, Height>::reserve(int f, int g) {
+  while (memory_usage().total_bytes() + insertion_bytes() > m_options.memory_limit_bytes) {
+    auto leaf_id{worst_leaf()};
+
+    if (leaf_id == NO_NODE) {
+      return false;
+    }
+
+    // Forgetting a leaf that is no worse would only lead to it being regenerated first
+    const auto& leaf{node(leaf_id)};
+
+    if (!(OpenEntry{f, g, NO_NODE} < OpenEntry{leaf.f, leaf.g, NO_NODE})) {
+      return false;
+    }
+
+    forget(leaf_id, false);
+  }
+
+  return true;
+}
+
+template <int Width, int Height>
+NodeId SmaStar<Width, Height>::worst_leaf() const {
+  for (auto it{m_open_list.rbegin()}; it != m_open_list.rend(); ++it) {
+    const auto& leaf{node(it->id)};
+
+    if (leaf.num_children == 0 && leaf.parent != NO_NODE && it->id != m_expanding_id) {
+      return it->id;
+    }
+  }
+
+  return NO_NODE;
+}
+
+template <int Width, int Height>
+void SmaStar<Width, Height>::forget(NodeId id, bool is_dead_end) {
+  auto grid{this->grid(id)};
+  m_closed_set.erase(grid.placements(), grid.hash(), grid.variant());
+
+  if (node(id).is_open) {
+    close(id);
+  }
+
+  if (id == m_last_id) {
+    m_last_id = NO_NODE;
+  }
+
+  auto parent_id{node(id).parent};
+  auto f{node(id).f};
+  node(id).parent = m_forgotten_id;
+  m_forgotten_id = id;
+
+  if (parent_id == NO_NODE) {
+    return;
+  }
+
+  auto& parent{node(parent_id)};
+  --parent.num_children;
+
+  if (!is_dead_end) {
+    back_up(parent_id, f);
+  } else if (parent.num_children == 0 && !parent.is_open && parent_id != m_expanding_id) {
+    forget(parent_id, true);
+  }
+}
+
+template <int Width, int Height>
+void SmaStar<Width, Height>::back_up(NodeId id, int f) {
+  auto& backed_up{node(id)};
+  backed_up.forgotten_f = std::min(f, backed_up.forgotten_f);
+
+  // The node goes back in the open list, so that the forgotten child is regenerated once no other
+  // node has a lower f
+  if (backed_up.is_open) {
+    close(id);
+  }
+
+  backed_up.f = backed_up.forgotten_f;
+  open(id);
+}
+
+template <int Width, int Height>
+void SmaStar<Width, Height>::open(NodeId id) {
+  auto& opened{node(id)};
+  m_open_list.insert({opened.f, opened.g, id});
+  opened.is_open = true;
+}
+
+template <int Width, int Height>
+void SmaStar<Width, Height>::close(NodeId id) {
+  auto& closed{node(id)};
+  m_open_list.erase({closed.f, closed.g, id});
+  closed.is_open = false;
+}
+
+template <int Width, int Height>
+MemoryUsage SmaStar<Width, Height>::memory_usage() const {
+  // Every chunk but the last is full
+  auto num_allocated{
+      m_node_chunks.empty()
+          ? 0
+          : (m_node_chunks.size() - 1) * CHUNK_SIZE + m_node_chunks.back().capacity()
+  };
+
+  return {
+      m_node_chunks.capacity() * sizeof(std::vector<SmaNode>) + num_allocated * sizeof(SmaNode),
+      m_open_list.size() * OPEN_ENTRY_BYTES,
+      m_closed_set.memory_bytes()
+  };
+}
+
+template <int Width, int Height>
+void SmaStar<Width, Height>::account_memory_usage() {
+  auto usage{memory_usage()};
+  auto total{usage.total_bytes()};
+
+  if (total > m_peak_memory.total_bytes()) {
+    m_peak_memory = usage;
+  }
+
+  auto change{total > m_reported_bytes ? total - m_reported_bytes : m_reported_bytes - total};
+
+  if (m_options.on_memory_usage && change != 0 && change >= m_options.memory_usage_step_bytes) {
+    m_reported_bytes = total;
+    m_options.on_memory_usage(usage);
+  }
+}
+
+template <int Width, int Height>
+std::size_t SmaStar<Width, Height>::insertion_bytes() const {
+  auto bytes{OPEN_ENTRY_BYTES + m_closed_set.insertion_bytes()};
+
+  // While the last chunk grows, its old nodes are also held until they have been moved
+  if (m_forgotten_id == NO_NODE) {
+    bytes += grown_chunk_size() * sizeof(SmaNode);
+  }
+
+  return bytes;
+}
+
+template <int Width, int Height>
+std::size_t SmaStar<Width, Height>::grown_chunk_size() const {
+  if (m_num_nodes % CHUNK_SIZE == 0) {
+    return m_node_chunks.empty() ? MIN_CHUNK_SIZE : CHUNK_SIZE;
+  }
+
+  auto chunk_capacity{m_node_chunks.back().capacity()};
+  return m_num_nodes % CHUNK_SIZE < chunk_capacity ? 0 : std::min(chunk_capacity * 2, CHUNK_SIZE);
+}
+
+template <int Width, int Height>
+Grid<Width, Height> SmaStar<Width, Height>::grid(NodeId id) const {
+  auto grid{m_root};
+
+  for (auto move : moves(id)) {
+    grid = grid.successor(move);
+  }
+
+  return grid;
+}
+
+template <int Width, int Height>
+std::vector<Move> SmaStar<Width, Height>::moves(NodeId id) const {
+  std::vector<Move> moves{};
+
+  for (; node(id).parent != NO_NODE; id = node(id).parent) {
+    moves.push_back(node(id).move());
+  }
+
+  std::ranges::reverse(moves);
+  return moves;
+}
+}
+
+template <int Width, int Height>
+AstarResult sma_star(const Problem<Width, Height>& problem, const AstarOptions& options) {
+  assert(options.tie_breaking == TieBreaking::DeepestFirst);
+
+  auto start_time{std::chrono::steady_clock::now()};
+  AstarResult result{};
+
+  if (!problem.is_target_enclosed()) {
+    SmaStar<Width, Height>{problem, options}.run(result);
+  }
+
+  auto finish_time{std::chrono::steady_clock::now()};
+  result.elapsed_secs
+      = std::chrono::duration_cast<std::chrono::duration<double>>(finish_time - start_time).count();
+
+  return result;
+}
+
+#define INSTANTIATE_SMA_STAR(width, height)                                                       \
+  template AstarResult sma_star<width, height>(                                                   \
+      const Problem<width, height>& problem, const AstarOptions& options                          \
+  );
+FOR_EACH_GRID_DIMENSIONS(INSTANTIATE_SMA_STAR)
+#undef INSTANTIATE_SMA_STAR
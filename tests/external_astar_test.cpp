@@ -0,0 +1,89 @@
+#include "../include/astar.h"
+#include "test_puzzles.h"
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace {
+// External-memory A* may use a fraction of the memory that the placements of the grid states A*
+// generates take, so that every search spills to disk
+constexpr std::size_t MEMORY_FRACTION{8};
+
+/**
+ * Returns the puzzles searched: the input files in `tests/`, and small random puzzles, some of
+ * which cannot be solved. Returns no puzzles if an input file could not be read.
+ */
+std::vector<TestPuzzle> test_puzzles() {
+  std::vector<TestPuzzle> puzzles{};
+
+  if (!add_input_files(puzzles)) {
+    return {};
+  }
+
+  add_random_puzzles(puzzles);
+  // Dense boards on which no tetromino reaches the target position, though it is not enclosed, so
+  // that searches close every bucket
+  add_dense_puzzles(puzzles, {38, 88, 94, 160, 238, 245, 265, 310, 365});
+
+  return puzzles;
+}
+}
+
+/**
+ * Checks that external-memory A*, whose grid states cannot fit within its memory limit, finds
+ * valid solutions of the same cost as A*, or none where A* finds none, with each heuristic,
+ * placement rule, and order of buckets.
+ */
+int main() {
+  auto puzzles{test_puzzles()};
+  int num_failures{0};
+  int num_searches{0};
+
+  if (puzzles.empty()) {
+    return EXIT_FAILURE;
+  }
+
+  for (const auto& [name, params, is_small] : puzzles) {
+    for (auto heuristic : {Heuristic::Static, Heuristic::FloodFill}) {
+      for (auto placement_rule : {PlacementRule::Anywhere, PlacementRule::Chain}) {
+        for (auto tie_breaking : {TieBreaking::DeepestFirst, TieBreaking::ShallowestFirst}) {
+          if (tie_breaking == TieBreaking::ShallowestFirst && !is_small) {
+            continue;
+          }
+
+          AstarOptions options{
+              .heuristic = heuristic,
+              .placement_rule = placement_rule,
+              .tie_breaking = tie_breaking
+          };
+          auto expected{astar(params, options)};
+
+          options.algorithm = Algorithm::ExternalAstar;
+          options.memory_limit_bytes
+              = static_cast<std::size_t>(expected.stats.generated) * placements_bytes(params)
+                / MEMORY_FRACTION;
+          auto actual{astar(params, options)};
+          ++num_searches;
+
+          if (actual.is_io_error || actual.is_solved != expected.is_solved
+              || actual.cost != expected.cost
+              || actual.path.size() != static_cast<std::size_t>(actual.cost)
+              || !is_valid_path(params, actual.is_solved, actual.path)) {
+            std::cout << "Failed: " << name << " (heuristic " << static_cast<int>(heuristic)
+                      << ", placement rule " << static_cast<int>(placement_rule)
+                      << ", tie-breaking " << static_cast<int>(tie_breaking) << "): expected cost "
+                      << expected.cost << ", found " << actual.cost << " after generating "
+                      << actual.stats.generated << " grid states"
+                      << (actual.is_io_error ? " (I/O error)" : "") << '\n';
+            ++num_failures;
+          }
+        }
+      }
+    }
+  }
+
+  std::cout << num_searches - num_failures << " of " << num_searches << " searches passed.\n";
+
+  return num_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
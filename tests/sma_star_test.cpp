@@ -0,0 +1,102 @@
+#include "../include/astar.h"
+#include "../include/generator.h"
+#include "test_puzzles.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+// SMA* may hold this many nodes per grid state on the optimal path (counting the start), so that
+// the limit holds little more than the paths being searched
+constexpr std::size_t NODES_PER_STEP{8};
+// Bytes held by each node and its entries in the open list and closed set, beyond its placements
+constexpr std::size_t NODE_OVERHEAD_BYTES{64};
+
+/**
+ * Returns the puzzles searched: the input files in `tests/`, small random puzzles, dense puzzles
+ * (most of which cannot be solved), and large boards without obstacles. Returns no puzzles if an
+ * input file could not be read.
+ */
+std::vector<TestPuzzle> test_puzzles() {
+  std::vector<TestPuzzle> puzzles{};
+
+  if (!add_input_files(puzzles)) {
+    return {};
+  }
+
+  add_random_puzzles(puzzles);
+  // Dense boards, on most of which the flood-fill heuristic finds the target position unreachable
+  add_dense_puzzles(puzzles, {38, 88, 94, 160, 238});
+
+  // On which a single chunk of closed set entries would take megabytes
+  GeneratorParams open_params{
+      .seed = 1, .width = 128, .height = 128, .obstacle_density = 0.0, .min_distance = 120
+  };
+
+  for (std::uint64_t index{0}; index < 2; ++index) {
+    if (auto params{generate_puzzle(open_params, index)}) {
+      puzzles.push_back({"open " + std::to_string(index), *params, false});
+    }
+  }
+
+  return puzzles;
+}
+}
+
+/**
+ * Checks that SMA*, whose memory limit holds only a few nodes per grid state on the optimal path,
+ * finds valid solutions of the same cost as A* within the limit, with each heuristic and placement
+ * rule, and reports the memory it holds while it searches.
+ */
+int main() {
+  auto puzzles{test_puzzles()};
+  int num_failures{0};
+  int num_searches{0};
+
+  if (puzzles.empty()) {
+    return EXIT_FAILURE;
+  }
+
+  for (const auto& [name, params, is_small] : puzzles) {
+    for (auto heuristic : {Heuristic::Static, Heuristic::FloodFill}) {
+      for (auto placement_rule : {PlacementRule::Anywhere, PlacementRule::Chain}) {
+        AstarOptions options{.heuristic = heuristic, .placement_rule = placement_rule};
+        auto expected{astar(params, options)};
+
+        options.algorithm = Algorithm::SmaStar;
+        options.memory_limit_bytes = static_cast<std::size_t>(expected.cost + 1) * NODES_PER_STEP
+                                     * (placements_bytes(params) + NODE_OVERHEAD_BYTES);
+        // Every change is reported, so the most reported is the peak
+        std::size_t max_reported_bytes{0};
+        options.on_memory_usage = [&max_reported_bytes](const MemoryUsage& usage) {
+          max_reported_bytes = std::max(usage.total_bytes(), max_reported_bytes);
+        };
+        options.memory_usage_step_bytes = 1;
+        auto actual{astar(params, options)};
+        ++num_searches;
+
+        if (actual.is_solved != expected.is_solved || actual.cost != expected.cost
+            || actual.path.size() != static_cast<std::size_t>(actual.cost)
+            || !is_valid_path(params, actual.is_solved, actual.path)
+            || actual.peak_memory.total_bytes() > options.memory_limit_bytes
+            || max_reported_bytes != actual.peak_memory.total_bytes()) {
+          std::cout << "Failed: " << name << " (heuristic " << static_cast<int>(heuristic)
+                    << ", placement rule " << static_cast<int>(placement_rule)
+                    << "): expected cost " << expected.cost << ", found " << actual.cost
+                    << " holding " << actual.peak_memory.total_bytes() << " of "
+                    << options.memory_limit_bytes << " bytes (" << max_reported_bytes
+                    << " reported)\n";
+          ++num_failures;
+        }
+      }
+    }
+  }
+
+  std::cout << num_searches - num_failures << " of " << num_searches << " searches passed.\n";
+
+  return num_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,161 @@
+#ifndef TEST_PUZZLES_H
+#define TEST_PUZZLES_H
+
+#include "../include/FlatBitGrid.h"
+#include "../include/Position.h"
+#include "../include/Tetromino.h"
+#include "../include/astar.h"
+#include "../include/generator.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * A puzzle searched by the tests, whose solutions are checked by `is_valid_path()`.
+ */
+struct TestPuzzle {
+  std::string name;
+  AstarParams params;
+  // Whether shallowest-first searches are quick enough to run, which on the input files in
+  // `tests/` expand millions of grid states
+  bool is_small;
+};
+
+/**
+ * Appends the input files in `tests/` to `puzzles`. Returns `false` if one could not be read.
+ */
+inline bool add_input_files(std::vector<TestPuzzle>& puzzles) {
+  for (std::string name : {"1.txt", "2.txt"}) {
+    AstarParams params{};
+
+    if (!read_astar_params(std::string{TETROMINO_ASTAR_TESTS_DIR} + "/" + name, params)) {
+      std::cout << "Error: Unable to read " << name << ".\n";
+      return false;
+    }
+
+    puzzles.push_back({name, params, false});
+  }
+
+  return true;
+}
+
+/**
+ * Appends small random puzzles to `puzzles`, some of which cannot be solved.
+ */
+inline void add_random_puzzles(std::vector<TestPuzzle>& puzzles) {
+  GeneratorParams generator_params{
+      .seed = 5,
+      .width = 10,
+      .height = 10,
+      .obstacle_density = 0.3,
+      .min_distance = 6,
+      .max_estimated_cost = 4
+  };
+
+  for (std::uint64_t index{0}; index < 16; ++index) {
+    if (auto params{generate_puzzle(generator_params, index)}) {
+      puzzles.push_back({"random " + std::to_string(index), *params, true});
+    }
+  }
+}
+
+/**
+ * Appends the dense 16x16 boards with indices `indices` to `puzzles`, on most of which no
+ * tetromino reaches the target position.
+ */
+inline void add_dense_puzzles(
+    std::vector<TestPuzzle>& puzzles, std::initializer_list<std::uint64_t> indices
+) {
+  GeneratorParams dense_params{.seed = 99, .width = 16, .height = 16, .obstacle_density = 0.55};
+
+  for (auto index : indices) {
+    if (auto params{generate_puzzle(dense_params, index)}) {
+      puzzles.push_back({"dense " + std::to_string(index), *params, true});
+    }
+  }
+}
+
+/**
+ * Returns the size of the placements of each grid state of `params`' board.
+ */
+inline std::size_t placements_bytes(const AstarParams& params) {
+  return with_problem(params, []<int Width, int Height>(const Problem<Width, Height>&) {
+    return sizeof(FlatBitGrid<Width, Height>);
+  });
+}
+
+/**
+ * Returns `true` if `path` is a solution of `params`, or is empty if `is_solved` is `false`. Each
+ * tetromino must be on the board, must not overlap obstacles, the start position, or earlier
+ * tetrominoes, and must be adjacent to the start position or an earlier tetromino, and the last
+ * must cover the target position.
+ */
+inline bool is_valid_path(
+    const AstarParams& params,
+    bool is_solved,
+    const std::vector<std::array<Position, Tetromino::SIZE>>& path
+) {
+  if (!is_solved) {
+    return path.empty();
+  }
+
+  auto index{[&params](Position pos) {
+    return static_cast<std::size_t>(pos.y) * params.width + pos.x;
+  }};
+  auto is_on_board{[&params](Position pos) {
+    return pos.x >= 0 && pos.x < params.width && pos.y >= 0 && pos.y < params.height;
+  }};
+
+  std::vector<bool> is_obstacle(static_cast<std::size_t>(params.width) * params.height);
+  std::vector<bool> is_placed(is_obstacle.size());
+
+  for (auto obstacle : params.obstacles) {
+    is_obstacle[index(obstacle)] = true;
+  }
+
+  is_placed[index(params.start)] = true;
+
+  for (const auto& tetromino : path) {
+    bool is_adjacent{false};
+
+    for (auto pos : tetromino) {
+      if (!is_on_board(pos) || is_obstacle[index(pos)] || is_placed[index(pos)]) {
+        return false;
+      }
+
+      for (Position neighbour :
+           {Position{pos.x - 1, pos.y},
+            Position{pos.x + 1, pos.y},
+            Position{pos.x, pos.y - 1},
+            Position{pos.x, pos.y + 1}}) {
+        is_adjacent = is_adjacent || (is_on_board(neighbour) && is_placed[index(neighbour)]);
+      }
+    }
+
+    if (!is_adjacent) {
+      return false;
+    }
+
+    for (auto pos : tetromino) {
+      is_placed[index(pos)] = true;
+    }
+  }
+
+  if (path.empty()) {
+    return params.start == params.target;
+  }
+
+  for (auto pos : path.back()) {
+    if (pos == params.target) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+#endif